@@ -9,6 +9,7 @@
 
 #include "ch32v30x_rcc.h"
 #include "ch32v30x_usbotg_device.h"
+#include "zf_driver_usb_cdc.h"
 
 
 
@@ -369,14 +370,7 @@ void DevEP1_OUT_Deal( UINT8 l )
 *******************************************************************************/
 void DevEP2_OUT_Deal( UINT8 l )
 {
-    UINT8 i;
-
-    for(i=0; i<l; i++)
-    {
-        pEP2_IN_DataBuf[i] = ~pEP2_OUT_DataBuf[i];
-    }
-
-    DevEP2_IN_Deal( l );
+    cdc_receive_pack( pEP2_OUT_DataBuf, l );
 }
 
 /*******************************************************************************
@@ -78,6 +78,7 @@
 //===================================================оƬ===================================================
 #include "zf_driver_adc.h"
 #include "zf_driver_delay.h"
+#include "zf_driver_dma.h"
 #include "zf_driver_dvp.h"
 #include "zf_driver_encoder.h"
 #include "zf_driver_exti.h"
@@ -136,9 +137,18 @@
 #include "isr.h"
 #include "UART_Data_Unpacker.h"
 #include "Ring_Buffer.h"
+#include "Binary_Frame.h"
+#include "Protocol_Engine.h"
+#include "Fast_Number.h"
+#include "Param_Store.h"
+#include "KV_Store.h"
+#include "Motion_Log.h"
 #include "XxxTimeSliceOffset.h"
+#include "XxxProtothread.h"
+#include "XxxHardRealTime.h"
 #include "Task_Manager.h"
 #include "DC_Motion.h"
+#include "Telemetry.h"
 //===================================================ûԶļ===================================================
 
 #endif
@@ -74,7 +74,7 @@ static void w25q32_write_dat(uint8 dat)
 }
 
 
-static void w25q32_write_dats(uint8 *dat, uint32 len)
+static void w25q32_write_dats(const uint8 *dat, uint32 len)
 {
     //    W25Q32_CS(0);
     spi_write_8bit_array(W25Q32_SPI, dat, len);
@@ -128,6 +128,39 @@ static uint8 w25q32_read_state(void)
 }
 
 
+static uint8 w25q32_transfer = 0;               // DMA  ɺ CS
+static uint8 w25q32_program = 1;                // ̻ ҪѯоƬæ ϵʱоƬܻɵǰĲ
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯƽ W25Q32 ״̬
+// ˵     void
+// ز     w25q32_state_enum   W25Q32_STATE_IDLE ʱԷµĶд
+// ʹʾ     if(W25Q32_STATE_IDLE == w25q32_get_state()) {...}
+// עϢ     DMA ɺ CS(ҳ CS ߺſʼ) ֮ѯ״̬Ĵֱ̻
+//              ûнеı̲ʱ SPI иƵ
+//-------------------------------------------------------------------------------------------------------------------
+w25q32_state_enum w25q32_get_state(void)
+{
+    if(w25q32_transfer)
+    {
+        if(spi_dma_busy(W25Q32_SPI))
+        {
+            return W25Q32_STATE_TRANSFER;
+        }
+        W25Q32_CS(1);
+        w25q32_transfer = 0;
+    }
+    if(w25q32_program)
+    {
+        if(w25q32_read_state() & 0x01)
+        {
+            return W25Q32_STATE_BUSY;
+        }
+        w25q32_program = 0;
+    }
+    return W25Q32_STATE_IDLE;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       ȴæ ڲ
 // ˵     void
@@ -135,7 +168,20 @@ static uint8 w25q32_read_state(void)
 //-------------------------------------------------------------------------------------------------------------------
 static void w25q32_wait_busy(void)
 {
-    while ((w25q32_read_state()&0x01)==0x01);   // ȴBUSYλ
+    while(W25Q32_STATE_IDLE != w25q32_get_state());    // ȴ DMA Լ BUSY λ
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       24bitַ ڲ
+// ˵     cmd             
+// ˵     addr            ַ24bit
+// ˵     dummy           ַĿֽ
+// ز     void
+//-------------------------------------------------------------------------------------------------------------------
+static void w25q32_write_cmd_addr(uint8 cmd, uint32 addr, uint8 dummy)
+{
+    uint8 head[5] = {cmd, (uint8)(addr >> 16), (uint8)(addr >> 8), (uint8)addr, 0xFF};
+    w25q32_write_dats(head, 4 + dummy);
 }
 
 
@@ -165,34 +211,16 @@ static uint16 w25q32_read_device_id(void)
 void w25q32_erase_chip(void)
 {
     w25q32_wait_busy();
+    w25q32_write_enable();                      //ÿβɺдʹԶҪ´
     W25Q32_CS(0);                               //ʹ
     w25q32_write_dat(W25Q32_CHIP_ERASE);        //Ƭ
     W25Q32_CS(1);                               //ȡƬѡ
+    w25q32_program = 1;
     w25q32_wait_busy();                         //ȴоƬ
 }
 
 
-//-------------------------------------------------------------------------------------------------------------------
-//      ȡһֽ ڲ
-// ˵     uint32        ȡַ24bit
-// ز     uint8           ȡֵ
-//  @since      v1.0
-// ʹʾ     w25q32_read_byte(0x000001);
-//-------------------------------------------------------------------------------------------------------------------
-static uint8 w25q32_read_byte(uint32 addr)
-{
-    uint8 temp;
-    W25Q32_CS(0);
-
-    w25q32_write_dat(W25Q32_READ_DATA);       // Ͷȡ
-    w25q32_write_dat((uint8)((addr)>>16));    // 24bitַ
-    w25q32_write_dat((uint8)((addr)>>8));
-    w25q32_write_dat((uint8)addr);
-    temp = w25q32_read_dat();                 // ȡһֽ
-
-    W25Q32_CS(1);
-    return temp;
-}
+static void w25q32_read_addr_dats(uint32 addr, uint8 *buff, uint16 len);
 
 //-------------------------------------------------------------------------------------------------------------------
 //      Уw25q32Ƿ
@@ -206,14 +234,16 @@ static uint8 w25q32_read_byte(uint32 addr)
 uint8 w25q32_check (w25q32_block_enum block_num, w25q32_section_enum sector_num, w25q32_page_enum page_num)
 {
     uint16 temp_loop;
+    uint8 page[W25Q32_PAGE_SIZE];
     uint32 addr = (W25Q32_BASE_ADDR         +
             W25Q32_BLOCK_SIZE*block_num     +
             W25Q32_SECTION_SIZE*sector_num  +
             W25Q32_PAGE_SIZE*page_num);     // ȡǰַ
 
-    for(temp_loop = 0; temp_loop < W25Q32_PAGE_SIZE; temp_loop++)       // ѭȡ Flash ֵ
+    w25q32_read_addr_dats(addr, page, W25Q32_PAGE_SIZE);                // ҳ ֽڷͶ
+    for(temp_loop = 0; temp_loop < W25Q32_PAGE_SIZE; temp_loop++)
     {
-        if( w25q32_read_byte(addr + temp_loop) != 0xff )                //  0xff Ǿֵ
+        if( page[temp_loop] != 0xff )                                   //  0xff Ǿֵ
             return 1;
     }
     return 0;
@@ -235,14 +265,8 @@ uint8 w25q32_erase_sector(w25q32_block_enum block_num, w25q32_section_enum secto
             W25Q32_SECTION_SIZE*sector_num +
             W25Q32_PAGE_SIZE*0);                    // ȡǰַ
 
-    W25Q32_CS(0);
-
-    w25q32_write_dat(W25Q32_SECTOR_ERASE);          // Ͳ
-    w25q32_write_dat((uint8)((addr)>>16));          // 24bitַ
-    w25q32_write_dat((uint8)((addr)>>8));
-    w25q32_write_dat((uint8)addr);
-
-    W25Q32_CS(1);
+    w25q32_wait_busy();
+    w25q32_erase_sector_start(addr);
     w25q32_wait_busy();                             // ȴ
     return 0;
 }
@@ -261,12 +285,15 @@ uint8 w25q32_erase_sector(w25q32_block_enum block_num, w25q32_section_enum secto
 //-------------------------------------------------------------------------------------------------------------------
 static void w25q32_read_addr_dats(uint32 addr, uint8 *buff, uint16 len)
 {
+    w25q32_wait_busy();
+    if(len >= W25Q32_DMA_MIN_LEN)
+    {
+        w25q32_read_addr_start(addr, buff, len);
+        w25q32_wait_busy();
+        return;
+    }
     W25Q32_CS(0);
-    w25q32_write_dat(W25Q32_FAST_READ);             // Ͷȡ
-    w25q32_write_dat((uint8)((addr)>>16));          // 24bitַ
-    w25q32_write_dat((uint8)((addr)>>8));
-    w25q32_write_dat((uint8)addr);
-    w25q32_read_dat();                              // ٶȡҪһֽΪֽڡ
+    w25q32_write_cmd_addr(W25Q32_FAST_READ, addr, 1);   // ٶȡҪַΪֽ
     w25q32_read_dats(buff, len);
 
     W25Q32_CS(1);//ȡƬѡ
@@ -284,16 +311,103 @@ static void w25q32_read_addr_dats(uint32 addr, uint8 *buff, uint16 len)
 //-------------------------------------------------------------------------------------------------------------------
 static void w25q32_write_addr_dats(uint32 addr, uint8 *buff, uint16 len)
 {
+    w25q32_wait_busy();
+    w25q32_write_addr_start(addr, buff, len);
+    w25q32_wait_busy();                             // ȴд
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯ W25Q32 Ƿڴ䡢̻
+// ˵     void
+// ز     uint8           1-æ 0-
+// ʹʾ     if(!w25q32_is_busy()) {...}
+// עϢ     ͬ w25q32_get_state() æʱܷµĶд
+//-------------------------------------------------------------------------------------------------------------------
+uint8 w25q32_is_busy(void)
+{
+    return (W25Q32_STATE_IDLE != w25q32_get_state());
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ַȡ ɿҳ
+// ˵     addr            ʼȡĵַ24bit
+// ˵     buf             ݴ洢
+// ˵     len             Ҫȡĳ(65535)
+// ز     void
+// ʹʾ     w25q32_read_addr(0x001000, buf, 64);
+// עϢ     ȴ֮ǰĲȡ ŷ С W25Q32_DMA_MIN_LEN ֽʱ DMA 
+//-------------------------------------------------------------------------------------------------------------------
+void w25q32_read_addr(uint32 addr, uint8 *buf, uint16 len)
+{
+    w25q32_read_addr_dats(addr, buf, len);
+}
 
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA ٶ(FAST_READ) ȴ
+// ˵     addr            ʼȡĵַ24bit
+// ˵     buf             ݴ洢
+// ˵     len             Ҫȡĳ 1-65535
+// ز     uint8           1-оƬæδ 0-ѷ
+// ʹʾ     if(0 == w25q32_read_addr_start(0x001000, buf, 256)) {...}
+// עϢ     ֮ w25q32_get_state() ѯ ص W25Q32_STATE_IDLE  buf еݲЧ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 w25q32_read_addr_start(uint32 addr, uint8 *buf, uint16 len)
+{
+    if(W25Q32_STATE_IDLE != w25q32_get_state())
+    {
+        return 1;
+    }
     W25Q32_CS(0);
+    w25q32_write_cmd_addr(W25Q32_FAST_READ, addr, 1);
+    w25q32_transfer = 1;
+    spi_transfer_8bit_dma(W25Q32_SPI, NULL, buf, len);
+    return 0;
+}
 
-    w25q32_write_dat(W25Q32_PAGE_PROGRAM);          // дҳ
-    w25q32_write_dat((uint8)((addr)>>16));          // 24bitַ
-    w25q32_write_dat((uint8)((addr)>>8));
-    w25q32_write_dat((uint8)addr);
-    w25q32_write_dats(buff, len);
+//-------------------------------------------------------------------------------------------------------------------
+//      ҳ ȴ
+// ˵     addr            ʼдĵַ24bit
+// ˵     buf             ݴ洢
+// ˵     len             Ҫдĳ(256,lenܳҳʣֽ)
+// ز     uint8           1-оƬæδ 0-ѷ
+// ʹʾ     w25q32_write_addr_start(0x001000, buf, 16);
+// עϢ      DMA  ֮ w25q32_get_state() ѯ(DMA ҳԼ0.7ms)
+//              ص W25Q32_STATE_IDLE ֮ǰ buf ޸ ͬһҳδд(0xFF)ֽڿԷֶα
+//-------------------------------------------------------------------------------------------------------------------
+uint8 w25q32_write_addr_start(uint32 addr, const uint8 *buf, uint16 len)
+{
+    if(W25Q32_STATE_IDLE != w25q32_get_state())
+    {
+        return 1;
+    }
+    w25q32_write_enable();                          // ÿα̡ɺдʹԶҪ´
+    W25Q32_CS(0);
+    w25q32_write_cmd_addr(W25Q32_PAGE_PROGRAM, addr, 0);    // дҳ24bitַ
+    w25q32_transfer = 1;
+    w25q32_program = 1;
+    spi_transfer_8bit_dma(W25Q32_SPI, buf, NULL, len);      // CS ڴɺ w25q32_get_state() 
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ȴ
+// ˵     addr            ַ24bit
+// ز     uint8           1-оƬæδ 0-ѷ
+// ʹʾ     w25q32_erase_sector_start(0x001000);
+// עϢ     ֮ w25q32_get_state() ѯ(Լ45ms 400ms)
+//-------------------------------------------------------------------------------------------------------------------
+uint8 w25q32_erase_sector_start(uint32 addr)
+{
+    if(W25Q32_STATE_IDLE != w25q32_get_state())
+    {
+        return 1;
+    }
+    w25q32_write_enable();                          // ÿα̡ɺдʹԶҪ´
+    W25Q32_CS(0);
+    w25q32_write_cmd_addr(W25Q32_SECTOR_ERASE, addr, 0);    // Ͳ24bitַ
     W25Q32_CS(1);
-    w25q32_wait_busy();                             // ȴд
+    w25q32_program = 1;
+    return 0;
 }
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -198,6 +198,15 @@ typedef enum
 #define W25Q32_CS(x)              (x? (gpio_high(W25Q32_CS_PIN)): (gpio_low(W25Q32_CS_PIN)))
 
 #define W25Q32_TIMEOUT_COUNT      0x00FF
+#define W25Q32_DMA_MIN_LEN        (16)                                        // ȡڸֽʱ DMA ̵ֱѯ
+
+// ö W25Q32 ״̬  öٶ岻û޸
+typedef enum
+{
+    W25Q32_STATE_IDLE,                                                      //  ԷµĶд
+    W25Q32_STATE_TRANSFER,                                                  // DMA 
+    W25Q32_STATE_BUSY,                                                      // оƬڲ̻
+}w25q32_state_enum;
 
 //================================================ ICM20602 ڲַ================================================
 #define W25Q32_WRITE_ENABLE             0x06
@@ -237,6 +246,13 @@ void  w25q32_write_page     (w25q32_block_enum block_num, w25q32_section_enum se
         uint8 *buf, uint16 len);
 uint8 w25q32_init();
 
+w25q32_state_enum w25q32_get_state (void);
+uint8 w25q32_is_busy        (void);
+void  w25q32_read_addr      (uint32 addr, uint8 *buf, uint16 len);
+uint8 w25q32_read_addr_start    (uint32 addr, uint8 *buf, uint16 len);
+uint8 w25q32_write_addr_start   (uint32 addr, const uint8 *buf, uint16 len);
+uint8 w25q32_erase_sector_start (uint32 addr);
+
 //SPI_FLASHдʹ
 
 #endif
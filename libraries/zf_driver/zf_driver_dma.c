@@ -0,0 +1,383 @@
+/*********************************************************************************************************************
+* CH32V307VCT6 Opensourec Library CH32V307VCT6 Դ⣩һڹٷ SDK ӿڵĵԴ
+* Copyright (c) 2022 SEEKFREE ɿƼ
+*
+* ļCH32V307VCT6 Դһ
+*
+* CH32V307VCT6 Դ 
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+*
+* ӦյԴͬʱյһ GPL ĸ
+* ûУ<https://www.gnu.org/licenses/>
+*
+* ע
+* Դʹ GPL3.0 Դ֤Э Ϊİ汾
+* Ӣİ libraries/doc ļµ GPL3_permission_statement.txt ļ
+* ֤ libraries ļ ļµ LICENSE ļ
+* ӭλʹò ޸ʱ뱣ɿƼİȨ
+*
+* ļ          zf_driver_dma
+* ˾          ɶɿƼ޹˾
+* 汾Ϣ          鿴 libraries/doc ļ version ļ 汾˵
+*           MounRiver Studio V1.8.1
+* ƽ̨          CH32V307VCT6
+*           https://seekfree.taobao.com/
+*
+* ޸ļ¼
+*                                                                    ע
+* 2026-10-19        Sxxx           first version
+********************************************************************************************************************/
+
+#include "zf_driver_dma.h"
+
+// ֹ޸ģڲʹû
+static DMA_Channel_TypeDef * const dma_channel_index[DMA_CHANNEL_NUM] =
+{
+    DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4, DMA1_Channel5, DMA1_Channel6, DMA1_Channel7,
+    DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4, DMA2_Channel5, DMA2_Channel6, DMA2_Channel7,
+    DMA2_Channel8, DMA2_Channel9, DMA2_Channel10, DMA2_Channel11,
+};
+static const uint8 dma_irq[DMA_CHANNEL_NUM] =
+{
+    DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn, DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+    DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn, DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn,
+    DMA2_Channel8_IRQn, DMA2_Channel9_IRQn, DMA2_Channel10_IRQn, DMA2_Channel11_IRQn,
+};
+static const uint32 dma_flag_gl[DMA_CHANNEL_NUM] =
+{
+    DMA1_FLAG_GL1, DMA1_FLAG_GL2, DMA1_FLAG_GL3, DMA1_FLAG_GL4, DMA1_FLAG_GL5, DMA1_FLAG_GL6, DMA1_FLAG_GL7,
+    DMA2_FLAG_GL1, DMA2_FLAG_GL2, DMA2_FLAG_GL3, DMA2_FLAG_GL4, DMA2_FLAG_GL5, DMA2_FLAG_GL6, DMA2_FLAG_GL7,
+    DMA2_FLAG_GL8, DMA2_FLAG_GL9, DMA2_FLAG_GL10, DMA2_FLAG_GL11,
+};
+// ͬһͨ TC HT TE ־Ϊȫֱ־ 1 2 3 λ  4 λΪĴѡλƶ
+#define DMA_FLAG_OF(gl, it)     (((gl) & 0xF0000000) | (((gl) & 0x0FFFFFFF) * (it)))
+
+typedef struct
+{
+    const char             *owner;                                              // ռ NULL Ϊ
+    dma_callback            callback;                                           // жϻص
+    void                   *arg;                                                // ص
+    uint8                   event;                                              // ж¼
+    uint8                   mode;                                               // ģʽ
+    volatile uint8          running;                                            // δ
+}dma_channel_struct;
+
+static dma_channel_struct dma_channel[DMA_CHANNEL_NUM];
+
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA ͨ
+// ˵     dma_ch          DMA ͨ ̶ͨ zf_driver_dma.h Ӧϵ
+// ˵     owner           ռ ڳͻʾ ǳַ
+// ز     uint8           0-ɹ 1-ѱռ
+// ʹʾ     if(dma_channel_request(DMA2_CH11, "UART8 RX")) {...}
+// עϢ     ͬһռ(ͬһַַ)ظ뷵سɹ ͻʱϢ
+//              ͬ DMA ̶ͬһͨʱͬʱʹ DMA  SPI1_TX  UART3_RX  DMA1_CH3
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma_channel_request (dma_channel_enum dma_ch, const char *owner)
+{
+    uint8 return_state = 0;
+    uint32 primask;
+
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    zf_assert(owner != NULL);
+
+    primask = interrupt_global_disable();
+    if(NULL == dma_channel[dma_ch].owner)
+    {
+        dma_channel[dma_ch].owner = owner;
+    }
+    else if(dma_channel[dma_ch].owner != owner)
+    {
+        return_state = 1;
+    }
+    interrupt_global_enable(primask);
+
+    if(return_state)
+    {
+        zf_log(0, "dma channel already in use");
+    }
+    return return_state;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ͷ DMA ͨ ֹͣ䲢رж
+// ˵     dma_ch          DMA ͨ
+// ز     void
+// ʹʾ     dma_channel_release(DMA2_CH11);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void dma_channel_release (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+
+    dma_stop(dma_ch);
+    interrupt_disable((IRQn_Type)dma_irq[dma_ch]);
+    DMA_ITConfig(dma_channel_index[dma_ch], DMA_IT_TC | DMA_IT_HT | DMA_IT_TE, DISABLE);
+    DMA_ClearITPendingBit(dma_flag_gl[dma_ch]);
+    dma_channel[dma_ch].callback = NULL;
+    dma_channel[dma_ch].arg = NULL;
+    dma_channel[dma_ch].event = 0;
+    dma_channel[dma_ch].owner = NULL;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ DMA ͨռ
+// ˵     dma_ch          DMA ͨ
+// ز     const char *    ռ з NULL
+// ʹʾ     if(NULL == dma_channel_owner(DMA1_CH1)) {...}
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+const char *dma_channel_owner (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    return dma_channel[dma_ch].owner;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA ͨ úֹͨͣ״̬  dma_start 
+// ˵     dma_ch          DMA ͨ Ҫ dma_channel_request 
+// ˵     transfer        ䷽  zf_driver_dma.h  dma_transfer_enum ö嶨
+// ˵     periph_addr     ݼĴַ 洢洢ʱΪԴַ
+// ˵     memory          洢ַ 洢洢ʱΪĿĵַ
+// ˵     len             ݸ( width ) 1-65535 ѭ˫ģʽΪݸ
+// ˵     width           ݿ 洢ͬ
+// ˵     mode            ģʽ DMA_MODE_NORMAL DMA_MODE_CIRCULAR DMA_MODE_DOUBLE_BUFFER  DMA_MODE_MEMORY_FIXED 
+// ˵     priority        ͨȼ ͨͬʱʱȼȴ
+// ز     void
+// ʹʾ     dma_init(DMA2_CH11, DMA_PERIPH_TO_MEMORY, (uint32)&UART8->DATAR, buffer, 256, DMA_WIDTH_8BIT, DMA_MODE_CIRCULAR, DMA_PRIORITY_HIGH);
+// עϢ      DMA ( USART_DMACmd)ɵ߿
+//              洢洢ֻõģʽ Ҫ ȫٴ
+//-------------------------------------------------------------------------------------------------------------------
+void dma_init (dma_channel_enum dma_ch, dma_transfer_enum transfer, uint32 periph_addr, void *memory, uint16 len, dma_width_enum width, uint8 mode, dma_priority_enum priority)
+{
+    DMA_InitTypeDef DMA_InitStructure = {0};
+
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    zf_assert(dma_channel[dma_ch].owner != NULL);                               // δͨ
+    zf_assert(memory != NULL);
+    zf_assert(DMA_MEMORY_TO_MEMORY != transfer || 0 == (mode & (DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER)));
+    zf_assert(0 == (mode & DMA_MODE_DOUBLE_BUFFER) || 0 == (len & 1));          // ˫Ҫһ
+
+    RCC_AHBPeriphClockCmd((dma_ch < DMA2_CH1) ? RCC_AHBPeriph_DMA1 : RCC_AHBPeriph_DMA2, ENABLE);
+
+    dma_channel[dma_ch].running = 0;
+    dma_channel[dma_ch].mode = mode;
+    DMA_DeInit(dma_channel_index[dma_ch]);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = periph_addr;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32)memory;
+    DMA_InitStructure.DMA_DIR = (DMA_MEMORY_TO_PERIPH == transfer) ? DMA_DIR_PeripheralDST : DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = len;
+    DMA_InitStructure.DMA_PeripheralInc = (DMA_MEMORY_TO_MEMORY == transfer) ? DMA_PeripheralInc_Enable : DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = (mode & DMA_MODE_MEMORY_FIXED) ? DMA_MemoryInc_Disable : DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = (uint32)width << 8;             // DMA_PeripheralDataSize_Byte/HalfWord/Word
+    DMA_InitStructure.DMA_MemoryDataSize = (uint32)width << 10;                // DMA_MemoryDataSize_Byte/HalfWord/Word
+    DMA_InitStructure.DMA_Mode = (mode & (DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER)) ? DMA_Mode_Circular : DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = (uint32)priority << 12;                   // DMA_Priority_Low/Medium/High/VeryHigh
+    DMA_InitStructure.DMA_M2M = (DMA_MEMORY_TO_MEMORY == transfer) ? DMA_M2M_Enable : DMA_M2M_Disable;
+    DMA_Init(dma_channel_index[dma_ch], &DMA_InitStructure);
+    DMA_ClearFlag(dma_flag_gl[dma_ch]);
+
+    if(dma_channel[dma_ch].event)                                               // ʱõж
+    {
+        dma_set_callback(dma_ch, dma_channel[dma_ch].event, dma_channel[dma_ch].callback, dma_channel[dma_ch].arg);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA ͨжϻص Ӧͨж
+// ˵     dma_ch          DMA ͨ
+// ˵     event           Ҫص¼ DMA_EVENT_HALF DMA_EVENT_COMPLETE DMA_EVENT_ERROR  0 Ϊرж
+// ˵     callback        ص Ϊ NULL(ֻжϻ  dma_irq_handler ֵ)
+// ˵     arg             ص
+// ز     void
+// ʹʾ     dma_set_callback(DMA2_CH11, DMA_EVENT_HALF | DMA_EVENT_COMPLETE, uart_rx_dma_callback, NULL);
+// עϢ     ҪڶӦ DMAx_Channelx_IRQHandler е dma_irq_handler жȼ dma_get_irqn ȡжϺź
+//              ˫ģʽ̶ж DMA_EVENT_HALF ʱǰһд(ѷ)Դ()
+//              DMA_EVENT_COMPLETE ʱһԴ ʱ DMA ʹһ Ҫһ봫֮ǰ
+//-------------------------------------------------------------------------------------------------------------------
+void dma_set_callback (dma_channel_enum dma_ch, uint8 event, dma_callback callback, void *arg)
+{
+    uint32 it = 0;
+
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    zf_assert(dma_channel[dma_ch].owner != NULL);
+
+    if(event && (dma_channel[dma_ch].mode & DMA_MODE_DOUBLE_BUFFER))
+    {
+        event |= DMA_EVENT_HALF | DMA_EVENT_COMPLETE;
+    }
+    it |= (event & DMA_EVENT_HALF)      ? DMA_IT_HT : 0;
+    it |= (event & DMA_EVENT_COMPLETE)  ? DMA_IT_TC : 0;
+    it |= (event & DMA_EVENT_ERROR)     ? DMA_IT_TE : 0;
+
+    interrupt_disable((IRQn_Type)dma_irq[dma_ch]);
+    dma_channel[dma_ch].callback = callback;
+    dma_channel[dma_ch].arg = arg;
+    dma_channel[dma_ch].event = event;
+    DMA_ITConfig(dma_channel_index[dma_ch], DMA_IT_TC | DMA_IT_HT | DMA_IT_TE, DISABLE);
+    if(it)
+    {
+        DMA_ITConfig(dma_channel_index[dma_ch], it, ENABLE);
+        interrupt_enable((IRQn_Type)dma_irq[dma_ch]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ DMA ͨжϺ
+// ˵     dma_ch          DMA ͨ
+// ز     IRQn_Type       жϺ
+// ʹʾ     interrupt_set_priority(dma_get_irqn(DMA2_CH11), (0 << 5) | 1);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+IRQn_Type dma_get_irqn (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    return (IRQn_Type)dma_irq[dma_ch];
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       DMA  ʹ dma_init õĵַ볤
+// ˵     dma_ch          DMA ͨ
+// ز     void
+// ʹʾ     dma_start(DMA2_CH11);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+void dma_start (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+
+    DMA_ClearFlag(dma_flag_gl[dma_ch]);
+    dma_channel[dma_ch].running = 1;
+    DMA_Cmd(dma_channel_index[dma_ch], ENABLE);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      洢ַ볤Ⱥ DMA 
+// ˵     dma_ch          DMA ͨ
+// ˵     memory          洢ַ
+// ˵     len             ݸ 1-65535
+// ز     void
+// ʹʾ     dma_restart(DMA2_CH10, tx_buffer, 32);
+// עϢ     ڵģʽͲͬݿ ɻصе 򡢿ȵò
+//-------------------------------------------------------------------------------------------------------------------
+void dma_restart (dma_channel_enum dma_ch, const void *memory, uint16 len)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    zf_assert(memory != NULL);
+
+    DMA_Cmd(dma_channel_index[dma_ch], DISABLE);                               // رͨ޸ĵַͼ
+    dma_channel_index[dma_ch]->MADDR = (uint32)memory;
+    DMA_SetCurrDataCounter(dma_channel_index[dma_ch], len);
+    dma_start(dma_ch);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ֹͣ DMA 
+// ˵     dma_ch          DMA ͨ
+// ز     void
+// ʹʾ     dma_stop(DMA2_CH11);
+// עϢ     δݸ dma_get_remaining 
+//-------------------------------------------------------------------------------------------------------------------
+void dma_stop (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+
+    DMA_Cmd(dma_channel_index[dma_ch], DISABLE);
+    dma_channel[dma_ch].running = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ȡ DMA ͨʣഫݸ
+// ˵     dma_ch          DMA ͨ
+// ز     uint16          ʣݸ ѭģʽ -ʣ Ϊǰдλ
+// ʹʾ     uint16 head = 256 - dma_get_remaining(DMA2_CH11);
+// עϢ
+//-------------------------------------------------------------------------------------------------------------------
+uint16 dma_get_remaining (dma_channel_enum dma_ch)
+{
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+    return DMA_GetCurrDataCounter(dma_channel_index[dma_ch]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯ DMA δǷ
+// ˵     dma_ch          DMA ͨ
+// ز     uint8           1- 0-ɡδ
+// ʹʾ     while(dma_is_busy(DMA1_CH2));
+// עϢ     ѭ˫ģʽһֱ 1 ֱ dma_stop
+//              жʱ dma_irq_handler ״̬ ѯɱ־
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma_is_busy (dma_channel_enum dma_ch)
+{
+    uint32 gl;
+
+    zf_assert(dma_ch < DMA_CHANNEL_NUM);
+
+    if(!dma_channel[dma_ch].running)
+    {
+        return 0;
+    }
+    if(dma_channel[dma_ch].mode & (DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER))
+    {
+        return 1;
+    }
+    gl = dma_flag_gl[dma_ch];
+    if(DMA_GetFlagStatus(DMA_FLAG_OF(gl, DMA_IT_TC)) == RESET && DMA_GetFlagStatus(DMA_FLAG_OF(gl, DMA_IT_TE)) == RESET)
+    {
+        return 1;
+    }
+    DMA_Cmd(dma_channel_index[dma_ch], DISABLE);
+    dma_channel[dma_ch].running = 0;
+    return 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      DMA ͨжϴ ־¼ûص
+// ˵     dma_ch          DMA ͨ
+// ز     uint8           δ¼( dma_set_callback ) 0 Ϊû
+// ʹʾ     void DMA2_Channel11_IRQHandler (void) { dma_irq_handler(DMA2_CH11); }
+// עϢ      isr.c Ӧ DMA ͨжϷе ֵжл
+//              ͬһжж¼ʱ    ˳ص
+//-------------------------------------------------------------------------------------------------------------------
+uint8 dma_irq_handler (dma_channel_enum dma_ch)
+{
+    dma_channel_struct *channel = &dma_channel[dma_ch];
+    uint32 gl = dma_flag_gl[dma_ch];
+    uint8 event = 0;
+
+    if(DMA_GetITStatus(DMA_FLAG_OF(gl, DMA_IT_HT)) != RESET)
+    {
+        event |= DMA_EVENT_HALF;
+    }
+    if(DMA_GetITStatus(DMA_FLAG_OF(gl, DMA_IT_TC)) != RESET)
+    {
+        event |= DMA_EVENT_COMPLETE;
+    }
+    if(DMA_GetITStatus(DMA_FLAG_OF(gl, DMA_IT_TE)) != RESET)
+    {
+        event |= DMA_EVENT_ERROR;
+    }
+    DMA_ClearITPendingBit(gl);
+
+    if((event & DMA_EVENT_ERROR) || ((event & DMA_EVENT_COMPLETE) && 0 == (channel->mode & (DMA_MODE_CIRCULAR | DMA_MODE_DOUBLE_BUFFER))))
+    {
+        channel->running = 0;                                                   // ־ dma_is_busy ѯ
+    }
+    event &= channel->event;
+    if(NULL != channel->callback)
+    {
+        for(uint8 i = DMA_EVENT_HALF; i <= DMA_EVENT_ERROR; i <<= 1)
+        {
+            if(event & i)
+            {
+                channel->callback(dma_ch, i, channel->arg);
+            }
+        }
+    }
+    return event;
+}
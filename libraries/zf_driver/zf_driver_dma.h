@@ -0,0 +1,130 @@
+/*********************************************************************************************************************
+* CH32V307VCT6 Opensourec Library CH32V307VCT6 Դ⣩һڹٷ SDK ӿڵĵԴ
+* Copyright (c) 2022 SEEKFREE ɿƼ
+*
+* ļCH32V307VCT6 Դһ
+*
+* CH32V307VCT6 Դ 
+* Ըᷢ GPLGNU General Public License GNUͨù֤
+*  GPL ĵ3棨 GPL3.0ѡģκκİ汾·/޸
+*
+* Դķϣܷãδκεı֤
+* ûԻʺض;ı֤
+* ϸμ GPL
+*
+* ӦյԴͬʱյһ GPL ĸ
+* ûУ<https://www.gnu.org/licenses/>
+*
+* ע
+* Դʹ GPL3.0 Դ֤Э Ϊİ汾
+* Ӣİ libraries/doc ļµ GPL3_permission_statement.txt ļ
+* ֤ libraries ļ ļµ LICENSE ļ
+* ӭλʹò ޸ʱ뱣ɿƼİȨ
+*
+* ļ          zf_driver_dma
+* ˾          ɶɿƼ޹˾
+* 汾Ϣ          鿴 libraries/doc ļ version ļ 汾˵
+*           MounRiver Studio V1.8.1
+* ƽ̨          CH32V307VCT6
+*           https://seekfree.taobao.com/
+*
+* ޸ļ¼
+*                                                                    ע
+* 2026-10-19        Sxxx           first version
+********************************************************************************************************************/
+
+#ifndef _zf_driver_dma_h
+#define _zf_driver_dma_h
+
+#include "ch32v30x.h"
+#include "ch32v30x_dma.h"
+#include "ch32v30x_rcc.h"
+
+#include "zf_common_debug.h"
+#include "zf_common_interrupt.h"
+
+//  DMA ̶ӵĳͨ ͬһͨͬһʱֻܸһʹ
+// öӦϵ(оƬֲ DMA ӳ)
+// SPI1     RX DMA1_CH2  TX DMA1_CH3        SPI2  RX DMA1_CH4  TX DMA1_CH5        SPI3  RX DMA2_CH1  TX DMA2_CH2
+// UART1    RX DMA1_CH5  TX DMA1_CH4        UART2 RX DMA1_CH6  TX DMA1_CH7        UART3 RX DMA1_CH3  TX DMA1_CH2
+// UART4    RX DMA2_CH3  TX DMA2_CH5        UART5 RX DMA2_CH2  TX DMA2_CH4        UART6 RX DMA2_CH7  TX DMA2_CH6
+// UART7    RX DMA2_CH9  TX DMA2_CH8        UART8 RX DMA2_CH11 TX DMA2_CH10       ADC1  DMA1_CH1
+// 洢洢䲻Ҫ ʹͨ
+typedef enum //  öٶ岻û޸
+{
+    DMA1_CH1,
+    DMA1_CH2,
+    DMA1_CH3,
+    DMA1_CH4,
+    DMA1_CH5,
+    DMA1_CH6,
+    DMA1_CH7,
+
+    DMA2_CH1,
+    DMA2_CH2,
+    DMA2_CH3,
+    DMA2_CH4,
+    DMA2_CH5,
+    DMA2_CH6,
+    DMA2_CH7,
+    DMA2_CH8,
+    DMA2_CH9,
+    DMA2_CH10,
+    DMA2_CH11,
+
+    DMA_CHANNEL_NUM,
+}dma_channel_enum;
+
+typedef enum
+{
+    DMA_MEMORY_TO_PERIPH,                                                       // 洢 ->  紮ڷ
+    DMA_PERIPH_TO_MEMORY,                                                       //  -> 洢 紮ڽ ADC 
+    DMA_MEMORY_TO_MEMORY,                                                       // 洢 -> 洢 ַΪԴַ ַ
+}dma_transfer_enum;
+
+typedef enum
+{
+    DMA_WIDTH_8BIT,
+    DMA_WIDTH_16BIT,
+    DMA_WIDTH_32BIT,
+}dma_width_enum;
+
+// ģʽ  DMA_MODE_MEMORY_FIXED ʹ
+#define DMA_MODE_NORMAL         (0x00)                                          // δ ɺֹͨͣ
+#define DMA_MODE_CIRCULAR       (0x01)                                          // ѭ  0 Զͷʼ
+#define DMA_MODE_DOUBLE_BUFFER  (0x02)                                          // ˫ ѭ ǰʹ  dma_set_callback ע
+#define DMA_MODE_MEMORY_FIXED   (0x10)                                          // 洢ַ ظͬһݻ
+
+typedef enum
+{
+    DMA_PRIORITY_LOW,
+    DMA_PRIORITY_MEDIUM,
+    DMA_PRIORITY_HIGH,
+    DMA_PRIORITY_VERY_HIGH,
+}dma_priority_enum;
+
+// ж¼ ʹ
+#define DMA_EVENT_HALF          (0x01)                                          // 
+#define DMA_EVENT_COMPLETE      (0x02)                                          // 
+#define DMA_EVENT_ERROR         (0x04)                                          // (ַ) ͨѱӲر
+
+typedef void (*dma_callback)(dma_channel_enum dma_ch, uint8 event, void *arg);  //  DMA ͨже event Ϊ¼
+
+
+uint8   dma_channel_request     (dma_channel_enum dma_ch, const char *owner);
+void    dma_channel_release     (dma_channel_enum dma_ch);
+const char *dma_channel_owner   (dma_channel_enum dma_ch);
+
+void    dma_init                (dma_channel_enum dma_ch, dma_transfer_enum transfer, uint32 periph_addr, void *memory, uint16 len, dma_width_enum width, uint8 mode, dma_priority_enum priority);
+void    dma_set_callback        (dma_channel_enum dma_ch, uint8 event, dma_callback callback, void *arg);
+IRQn_Type dma_get_irqn          (dma_channel_enum dma_ch);
+
+void    dma_start               (dma_channel_enum dma_ch);
+void    dma_restart             (dma_channel_enum dma_ch, const void *memory, uint16 len);
+void    dma_stop                (dma_channel_enum dma_ch);
+uint16  dma_get_remaining       (dma_channel_enum dma_ch);
+uint8   dma_is_busy             (dma_channel_enum dma_ch);
+
+uint8   dma_irq_handler         (dma_channel_enum dma_ch);
+
+#endif
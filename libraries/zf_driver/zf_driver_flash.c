@@ -67,7 +67,7 @@ uint8 flash_check (uint32 sector_num, uint32 page_num)
 
     for(temp_loop = 0; temp_loop < FLASH_PAGE_SIZE; temp_loop+=4)                                       // ѭȡ Flash ֵ
     {
-        if( (*(__IO u32*) (flash_addr+temp_loop)) != 0xE339E339 )                                       // õƬ 0xE339E339 Ǿֵ
+        if( (*(__IO u32*) (flash_addr+temp_loop)) != FLASH_ERASED_WORD )                                       // õƬ 0xE339E339 Ǿֵ
         {
             return_state = 1;
             break;
@@ -203,6 +203,54 @@ uint8 flash_write_page (uint32 sector_num, uint32 page_num, const uint32 *buf, u
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------
+//      ָλ׷ӱɸ 
+// ˵     sector_num      Ҫд Χ <0 - 63>
+// ˵     offset          ڵֽƫ   Χ <0 - 4092>  4 ֽڶ
+// ˵     buf             Ҫдݵַ   ͱΪ uint32
+// ˵     len             Ҫдݳ() offset+len*4 С
+// ز     uint8           1-ʾʧ 0-ʾɹ
+// ʹʾ     flash_write_words(63, 16, data_buffer, 3);
+// עϢ     Ŀλñǲ״̬(FLASH_ERASED_WORD) 򷵻ʧҲд
+//              ־ʽ洢 ÿֻļ ÿβ
+//-------------------------------------------------------------------------------------------------------------------
+uint8 flash_write_words (uint32 sector_num, uint32 offset, const uint32 *buf, uint16 len)
+{
+    zf_assert(sector_num <= FLASH_MAX_SECTION_INDEX);                                                   // Χ 0-63
+    zf_assert((offset & 3) == 0);                                                                       // 4 ֽڶ
+    zf_assert(offset + (uint32)len * 4 <= FLASH_SECTION_SIZE);
+    uint8 return_state = 0;
+    volatile FLASH_Status gFlashStatus = FLASH_COMPLETE;
+    uint32 flash_addr = FLASH_BASE_ADDR + FLASH_SECTION_SIZE * sector_num + offset;                     // ȡǰ Flash ַ
+    uint16 temp_loop;
+
+    for(temp_loop = 0; temp_loop < len; temp_loop++)                                                    // ֻд״̬
+    {
+        if( (*(__IO u32*) (flash_addr + temp_loop * 4)) != FLASH_ERASED_WORD )
+        {
+            return 1;
+        }
+    }
+
+    uint32 primask = interrupt_global_disable();
+    FLASH_Unlock();                                                                                     //  Flash
+    FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPRTERR);                           // ־
+    while(len--)                                                                                        // ݳ
+    {
+        gFlashStatus = FLASH_ProgramWord(flash_addr, *buf++);                                           //  32bit д
+        if(gFlashStatus != FLASH_COMPLETE)                                                              // ȷϲǷɹ
+        {
+            return_state = 1;
+            break;
+        }
+        flash_addr += 4;                                                                                // ַ
+    }
+    FLASH_Lock();                                                                                       //  Flash
+    interrupt_global_enable(primask);
+
+    return return_state;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      ָ FLASH ָҳȡݵ
 // ˵     sector_num      Ҫд Χ <0 - 63>
@@ -46,6 +46,7 @@
 #define FLASH_PAGE_SIZE             (0x00000400)                // 1K byte
 #define FLASH_SECTION_SIZE          (FLASH_PAGE_SIZE*4)         // 4K byte
 #define FLASH_OPERATION_TIME_OUT    0x0FFF
+#define FLASH_ERASED_WORD           (0xE339E339)                // õƬֵ
 
 #define FLASH_DATA_BUFFER_SIZE      (FLASH_PAGE_SIZE/sizeof(flash_data_union))  // Զÿҳܹ¶ٸ
 
@@ -73,6 +74,7 @@ uint8   flash_check                         (uint32 sector_num, uint32 page_num)
 uint8   flash_erase_sector                  (uint32 sector_num, uint32 page_num);
 void    flash_read_page                     (uint32 sector_num, uint32 page_num, uint32 *buf, uint16 len);
 uint8   flash_write_page                    (uint32 sector_num, uint32 page_num, const uint32 *buf, uint16 len);
+uint8   flash_write_words                   (uint32 sector_num, uint32 offset, const uint32 *buf, uint16 len);
 
 void    flash_read_page_to_buffer           (uint32 sector_num, uint32 page_num);
 uint8   flash_write_page_from_buffer        (uint32 sector_num, uint32 page_num);
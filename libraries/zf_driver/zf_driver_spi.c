@@ -33,11 +33,19 @@
 * 2022-09-15        W            first version
 ********************************************************************************************************************/
 
+#include "zf_driver_dma.h"
 #include "zf_driver_gpio.h"
 #include "zf_driver_spi.h"
 
 const uint32 spi_index[3] = {SPI1_BASE, SPI2_BASE, SPI3_BASE};
 
+//  SPI ̶ DMA ͨ SPI1 DMA1_CH2/3 SPI2 DMA1_CH4/5 SPI3 DMA2_CH1/2
+static const dma_channel_enum spi_dma_rx_channel[3] = {DMA1_CH2, DMA1_CH4, DMA2_CH1};
+static const dma_channel_enum spi_dma_tx_channel[3] = {DMA1_CH3, DMA1_CH5, DMA2_CH2};
+static const char * const spi_dma_owner[3] = {"SPI1", "SPI2", "SPI3"};          // ͨռ  zf_driver_dma ͻ
+static uint8 spi_dma_dummy[3];                                                  // ͻʱ͵ 0xFF ʱյĶֽ
+static uint8 spi_dma_running[3];
+
 //-------------------------------------------------------------------------------------------------------------------
 //       SPI ӿд 8bit 
 // ˵     spi_n           SPI ģ  zf_driver_spi.h  spi_index_enum ö嶨
@@ -464,6 +472,97 @@ void spi_transfer_16bit (spi_index_enum spi_n, const uint16 *write_buffer, uint1
     }
 }
 
+//-------------------------------------------------------------------------------------------------------------------
+//       SPI 8bit ѯ DMA ͨʱ spi_transfer_8bit_dma
+// ˵     write_buffer    ͵ݻַ(ֻ NULL  0xFF)
+// ˵     read_buffer     ʱյݵĴ洢ַ(Ҫ NULL)
+// ز     void
+// עϢ     ڲ
+//-------------------------------------------------------------------------------------------------------------------
+static void spi_transfer_8bit_polling (spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len)
+{
+    SPI_TypeDef *spi = (SPI_TypeDef *)(spi_index[spi_n]);
+
+    spi->DATAR;
+
+    while(len--)
+    {
+        spi->DATAR = (NULL == write_buffer) ? 0xFF : *(write_buffer++);
+        while((spi->STATR & SPI_I2S_FLAG_BSY) != RESET);
+        if(read_buffer != NULL)
+        {
+            *read_buffer++ = spi->DATAR;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       SPI 8bit DMA   ͬʱе
+// ˵     spi_n           SPI ģ  zf_driver_spi.h  spi_index_enum ö嶨
+// ˵     write_buffer    ͵ݻַ(ֻ NULL  0xFF)
+// ˵     read_buffer     ʱյݵĴ洢ַ(Ҫ NULL)
+// ˵     len              1-65535
+// ز     void
+// ʹʾ     spi_transfer_8bit_dma(SPI_3, NULL, buf, 256); while(spi_dma_busy(SPI_3));
+// עϢ     ǰ޸  spi_dma_busy() ѯ ǰܵ SPI շ
+//              һεʱͨ zf_driver_dma  spi_dma_rx_channel/spi_dma_tx_channel ͨ
+//              ͨռʱ˻ѯ ʱѴ spi_dma_busy()  0
+//-------------------------------------------------------------------------------------------------------------------
+void spi_transfer_8bit_dma (spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len)
+{
+    SPI_TypeDef *spi = (SPI_TypeDef *)(spi_index[spi_n]);
+    dma_channel_enum rx_channel = spi_dma_rx_channel[spi_n];
+    dma_channel_enum tx_channel = spi_dma_tx_channel[spi_n];
+
+    zf_assert(len > 0 && len <= 0xFFFF);
+    if(dma_channel_request(rx_channel, spi_dma_owner[spi_n]))
+    {
+        spi_transfer_8bit_polling(spi_n, write_buffer, read_buffer, len);       // ͨͻ dma_channel_request ʾ
+        return;
+    }
+    if(dma_channel_request(tx_channel, spi_dma_owner[spi_n]))
+    {
+        dma_channel_release(rx_channel);                                        // ͨͬʱ ռŽͨ
+        spi_transfer_8bit_polling(spi_n, write_buffer, read_buffer, len);
+        return;
+    }
+    spi_dma_dummy[spi_n] = 0xFF;
+
+    dma_init(rx_channel, DMA_PERIPH_TO_MEMORY, (uint32)&spi->DATAR, (NULL == read_buffer) ? &spi_dma_dummy[spi_n] : read_buffer, (uint16)len,
+             DMA_WIDTH_8BIT, (NULL == read_buffer) ? (DMA_MODE_NORMAL | DMA_MODE_MEMORY_FIXED) : DMA_MODE_NORMAL, DMA_PRIORITY_VERY_HIGH);  //  
+    dma_init(tx_channel, DMA_MEMORY_TO_PERIPH, (uint32)&spi->DATAR, (NULL == write_buffer) ? &spi_dma_dummy[spi_n] : (void *)write_buffer, (uint16)len,
+             DMA_WIDTH_8BIT, (NULL == write_buffer) ? (DMA_MODE_NORMAL | DMA_MODE_MEMORY_FIXED) : DMA_MODE_NORMAL, DMA_PRIORITY_HIGH);
+
+    spi->DATAR;                                                                 // ѯշµĽ ᱻ DMA һֽ
+    spi_dma_running[spi_n] = 1;
+    dma_start(rx_channel);
+    dma_start(tx_channel);
+    SPI_I2S_DMACmd(spi, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, ENABLE);         // ʼ
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//       ѯ SPI DMA Ƿ ʱر DMA 
+// ˵     spi_n           SPI ģ  zf_driver_spi.h  spi_index_enum ö嶨
+// ز     uint8           1- 0-(ûд)
+// ʹʾ     if(!spi_dma_busy(SPI_3)) {...}
+// עϢ     ԽͨΪ׼ ʱһֽѾƳ ֱ CS
+//-------------------------------------------------------------------------------------------------------------------
+uint8 spi_dma_busy (spi_index_enum spi_n)
+{
+    if(!spi_dma_running[spi_n])
+    {
+        return 0;
+    }
+    if(dma_is_busy(spi_dma_rx_channel[spi_n]))
+    {
+        return 1;
+    }
+    SPI_I2S_DMACmd((SPI_TypeDef *)(spi_index[spi_n]), SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx, DISABLE);
+    dma_stop(spi_dma_tx_channel[spi_n]);
+    spi_dma_running[spi_n] = 0;
+    return 0;
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //       SPI ӿڳʼ
 // ˵     spi_n           SPI ģ  zf_driver_spi.h  spi_index_enum ö嶨
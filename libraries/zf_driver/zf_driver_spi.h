@@ -38,6 +38,7 @@
 
 #include "ch32v30x_spi.h"
 #include "ch32v30x_rcc.h"
+#include "ch32v30x_dma.h"
 #include "ch32v30x_gpio.h"
 
 #include "zf_common_debug.h"
@@ -139,6 +140,8 @@ void        spi_read_16bit_registers        (spi_index_enum spi_n, const uint16
 
 void        spi_transfer_8bit               (spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len);
 void        spi_transfer_16bit              (spi_index_enum spi_n, const uint16 *write_buffer, uint16 *read_buffer, uint32 len);
+void        spi_transfer_8bit_dma           (spi_index_enum spi_n, const uint8 *write_buffer, uint8 *read_buffer, uint32 len);
+uint8       spi_dma_busy                    (spi_index_enum spi_n);
 
 void        spi_init                        (spi_index_enum spi_n, spi_mode_enum mode, uint32 baud, spi_pin_enum sck_pin, spi_pin_enum mosi_pin, spi_pin_enum miso_pin, gpio_pin_enum cs_pin);
 
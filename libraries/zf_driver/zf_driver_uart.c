@@ -39,6 +39,18 @@
 const uint8 uart_irq[] = {USART1_IRQn, USART2_IRQn, USART3_IRQn, UART4_IRQn, UART5_IRQn, UART6_IRQn, UART7_IRQn, UART8_IRQn};
 const uint32 uart_index[] = {USART1_BASE, USART2_BASE, USART3_BASE, UART4_BASE, UART5_BASE, UART6_BASE, UART7_BASE, UART8_BASE};
 
+typedef struct                                                                  // 첽Ͷ ѭд ж϶
+{
+    uint8                  *buffer;                                             // д洢 NULL Ϊδ첽
+    uint16                  mask;                                               // 洢С-1
+    volatile uint16         head;                                               // дλ ֻ uart_write_buffer_async ޸
+    volatile uint16         tail;                                               // λ ֻ uart_tx_handler ޸
+    volatile uint8          sending;                                            //  һֽƳ TC ж
+    uart_tx_callback        callback;                                           // ȫɻص же
+}uart_tx_queue_struct;
+
+static uart_tx_queue_struct uart_tx_queue[8];
+
 //-------------------------------------------------------------------------------------------------------------------
 //      ڷһֽ
 // ˵     uartn       ͨ
@@ -86,6 +98,139 @@ void uart_write_string(uart_index_enum uartn, const char *str)
 
 
 
+//-------------------------------------------------------------------------------------------------------------------
+//      ô첽
+// ˵     uartn       ͨ
+// ˵     buffer      Ͷд洢 ɵṩ һֱЧ
+// ˵     size        洢С  2   32768
+// ˵     callback    ȫ(һֽƳ)ʱĻص ڴже Ҫ NULL
+// ز     void
+// ʹʾ     static uint8 tx_buffer[256]; uart_tx_async_init(UART_7, tx_buffer, sizeof(tx_buffer), NULL);
+// עϢ      uart_init ֮ ڸôڵжϷе uart_tx_handler
+//              жȼøôе(ж) ûùʱΪĬȼ
+//-------------------------------------------------------------------------------------------------------------------
+void uart_tx_async_init(uart_index_enum uartn, uint8 *buffer, uint16 size, uart_tx_callback callback)
+{
+    zf_assert(buffer != NULL);
+    zf_assert(size >= 2 && size <= 32768 && (size & (size - 1)) == 0);        // С 2 
+
+    USART_ITConfig(((USART_TypeDef*)uart_index[uartn]), USART_IT_TXE, DISABLE);
+    USART_ITConfig(((USART_TypeDef*)uart_index[uartn]), USART_IT_TC, DISABLE);
+    uart_tx_queue[uartn].buffer = buffer;
+    uart_tx_queue[uartn].mask = size - 1;
+    uart_tx_queue[uartn].head = 0;
+    uart_tx_queue[uartn].tail = 0;
+    uart_tx_queue[uartn].sending = 0;
+    uart_tx_queue[uartn].callback = callback;
+    interrupt_enable((IRQn_Type)uart_irq[uartn]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      첽 뷢Ͷк ɷжֽڷ
+// ˵     uartn       ͨ
+// ˵     buff        Ҫ͵ַ غ󼴿޸
+// ˵     len         ݳ
+// ز     uint32      ʵʷеĳ ʣռ䲻ʱֻܷµĲ
+// ʹʾ     uart_write_buffer_async(UART_7, buff, 10);
+// עϢ     Ҫȵ uart_tx_async_init ÿֻһ(綼ѭ)
+//              첽δʱҪͬһڵͺ ֽ˳ύ
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_write_buffer_async(uart_index_enum uartn, const uint8 *buff, uint32 len)
+{
+    uart_tx_queue_struct *queue = &uart_tx_queue[uartn];
+    uint32 free_size;
+    uint32 count;
+    uint32 primask;
+
+    zf_assert(buff != NULL);
+    zf_assert(queue->buffer != NULL);
+
+    free_size = queue->mask - (uint16)(queue->head - queue->tail);
+    count = (len < free_size) ? len : free_size;
+    for(uint32 i = 0; i < count; i ++)
+    {
+        queue->buffer[(queue->head + i) & queue->mask] = buff[i];
+    }
+    if(count)
+    {
+        primask = interrupt_global_disable();                                   // ждͬһƼĴ
+        queue->head += count;
+        queue->sending = 1;
+        USART_ITConfig(((USART_TypeDef*)uart_index[uartn]), USART_IT_TC, DISABLE);
+        USART_ITConfig(((USART_TypeDef*)uart_index[uartn]), USART_IT_TXE, ENABLE);
+        interrupt_global_enable(primask);
+    }
+    return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      첽Ͷʣռ
+// ˵     uartn       ͨ
+// ز     uint32      Էֽ
+// ʹʾ     if(uart_tx_async_free(UART_7) >= len) uart_write_buffer_async(UART_7, buff, len);
+//-------------------------------------------------------------------------------------------------------------------
+uint32 uart_tx_async_free(uart_index_enum uartn)
+{
+    if(uart_tx_queue[uartn].buffer == NULL)
+    {
+        return 0;
+    }
+    return uart_tx_queue[uartn].mask - (uint16)(uart_tx_queue[uartn].head - uart_tx_queue[uartn].tail);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      ѯ첽Ƿ
+// ˵     uartn       ͨ
+// ز     uint8       1-лݻһֽδƳ 0-
+// ʹʾ     while(uart_tx_async_busy(UART_7));
+//-------------------------------------------------------------------------------------------------------------------
+uint8 uart_tx_async_busy(uart_index_enum uartn)
+{
+    return uart_tx_queue[uartn].sending;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      첽жϴ
+// ˵     uartn       ͨ
+// ز     void
+// ʹʾ     uart_tx_handler(UART_7);
+// עϢ      isr.c ӦڵжϷе û첽ʱֱӷ
+//              TXE жһֽ пպΪȴ TC ж һֽƳɻص
+//-------------------------------------------------------------------------------------------------------------------
+void uart_tx_handler(uart_index_enum uartn)
+{
+    uart_tx_queue_struct *queue = &uart_tx_queue[uartn];
+    USART_TypeDef *uart = (USART_TypeDef*)uart_index[uartn];
+
+    if(queue->buffer == NULL)
+    {
+        return;
+    }
+    if(USART_GetITStatus(uart, USART_IT_TXE) != RESET)
+    {
+        if(queue->tail != queue->head)
+        {
+            uart->DATAR = queue->buffer[queue->tail & queue->mask];             // дݼĴͬʱ TXE
+            queue->tail ++;
+        }
+        else
+        {
+            USART_ITConfig(uart, USART_IT_TXE, DISABLE);
+            USART_ITConfig(uart, USART_IT_TC, ENABLE);
+        }
+    }
+    if(USART_GetITStatus(uart, USART_IT_TC) != RESET)
+    {
+        USART_ITConfig(uart, USART_IT_TC, DISABLE);
+        USART_ClearITPendingBit(uart, USART_IT_TC);
+        queue->sending = 0;
+        if(queue->callback != NULL)
+        {
+            queue->callback(uartn);
+        }
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      򿪴ڽж
 // ˵     uartn       ͨ
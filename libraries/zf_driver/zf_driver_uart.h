@@ -209,6 +209,8 @@ typedef enum//  
 
 
 
+typedef void (*uart_tx_callback)(uart_index_enum uart_n);                       // 첽ɻص
+
 extern const uint32 uart_index[];
 
 
@@ -218,6 +220,12 @@ void    uart_write_byte         (uart_index_enum uart_n, const uint8 dat);
 void    uart_write_buffer       (uart_index_enum uart_n, const uint8 *buff, uint32 len);
 void    uart_write_string       (uart_index_enum uart_n, const char *str);
 
+void    uart_tx_async_init      (uart_index_enum uart_n, uint8 *buffer, uint16 size, uart_tx_callback callback);
+uint32  uart_write_buffer_async (uart_index_enum uart_n, const uint8 *buff, uint32 len);
+uint32  uart_tx_async_free      (uart_index_enum uart_n);
+uint8   uart_tx_async_busy      (uart_index_enum uart_n);
+void    uart_tx_handler         (uart_index_enum uart_n);
+
 uint8   uart_read_byte                      (uart_index_enum uartn);
 uint8   uart_query_byte                     (uart_index_enum uartn, uint8 *dat);
 
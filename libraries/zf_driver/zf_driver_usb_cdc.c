@@ -36,6 +36,8 @@
 #include "zf_driver_delay.h"
 #include "zf_driver_usb_cdc.h"
 
+static usb_cdc_rx_callback_t usb_cdc_rx_callback = NULL;                   // ˵2ջص
+
 
 
 //-------------------------------------------------------------------------------------------------------------------
@@ -66,6 +68,33 @@ void cdc_send_pack(const uint8 *p, uint32 length)
 }
 
 
+//-------------------------------------------------------------------------------------------------------------------
+//      USB_CDCջص
+// ˵     callback    յһʱ(USBжִ) NULLյ
+// ز     void
+// ʹʾ     cdc_set_rx_callback(cdc_port_receive);
+// עϢ     صֻӦݷ뻺 Ҫ
+//-------------------------------------------------------------------------------------------------------------------
+void cdc_set_rx_callback(usb_cdc_rx_callback_t callback)
+{
+    usb_cdc_rx_callback = callback;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+//      USB_CDCյһ ɶ˵2 OUTжϵ
+// ˵     *p          յָ
+// ˵     length      ݳ
+// ز     void
+// עϢ     ڲ ûҪ
+//-------------------------------------------------------------------------------------------------------------------
+void cdc_receive_pack(const uint8 *p, uint32 length)
+{
+    if(NULL != usb_cdc_rx_callback)
+    {
+        usb_cdc_rx_callback(p, length);
+    }
+}
+
 //-------------------------------------------------------------------------------------------------------------------
 //      ͼݵλ
 // ˵     *image          ͼ
@@ -36,9 +36,15 @@
 #ifndef _zf_driver_usb_cdc_h
 #define _zf_driver_usb_cdc_h
 
+#include "zf_common_typedef.h"
+
 #include "ch32v30x_usbotg_device.h"
 
+typedef void (*usb_cdc_rx_callback_t)(const uint8 *p, uint32 length);
+
 void cdc_send_pack(const uint8 *p, uint32 length);
+void cdc_set_rx_callback(usb_cdc_rx_callback_t callback);
+void cdc_receive_pack(const uint8 *p, uint32 length);
 void camera_send_image_usb_cdc(const uint8 *image, uint32 length);
 void usb_cdc_init( void );
 
@@ -0,0 +1,321 @@
+/*********************************************************************************************************************
+ * 二进制帧编解码，帧格式与用法见 Binary_Frame.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，长度前缀+硬件CRC32的二进制帧，带类型载荷
+ * 2026-10-19     Sxxx      V1.1，新增批量帧，一帧携带多个标签/数值
+ * 2026-10-19     Sxxx      V1.2，新增带序号的请求/响应帧
+ * 2026-10-19     Sxxx      V1.3，新增读取帧保留标签 BINFRAME_TAG_GET
+ ********************************************************************************************************************/
+#include "Binary_Frame.h"
+#include "string.h"
+#include "ch32v30x.h"
+#include "ch32v30x_crc.h"
+#include "ch32v30x_rcc.h"
+
+#define BINFRAME_CRC_POLY 0x04C11DB7UL // CRC外设多项式
+
+// 各载荷类型的长度，0表示不定长
+static const uint8_t BinFrame_type_size[BINFRAME_TYPE_MAX] = {
+    [BINFRAME_TYPE_RAW] = 0,
+    [BINFRAME_TYPE_U8] = 1,
+    [BINFRAME_TYPE_I8] = 1,
+    [BINFRAME_TYPE_U16] = 2,
+    [BINFRAME_TYPE_I16] = 2,
+    [BINFRAME_TYPE_U32] = 4,
+    [BINFRAME_TYPE_I32] = 4,
+    [BINFRAME_TYPE_F32] = 4,
+    [BINFRAME_TYPE_BATCH] = 0,
+    [BINFRAME_TYPE_REQUEST] = 0,
+    [BINFRAME_TYPE_RESPONSE] = 0,
+};
+
+/*
+ * @brief 打开CRC外设时钟
+ */
+void BinFrame_Init(void)
+{
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
+}
+
+/**
+ *  @brief 用CRC外设计算CRC32
+ *  @param data 数据，4字节对齐时整字部分用 CRC_CalcBlockCRC() 一次送入
+ *  @param len  字节数，末尾不足4字节时补0成一个字
+ *  @return CRC32
+ *  @warning 不可重入，不要在中断和主循环中同时使用
+ */
+uint32_t BinFrame_CRC(const uint8_t *data, uint16_t len)
+{
+    uint16_t words = len / 4;
+    uint8_t rest = len % 4;
+    uint32_t word = 0;
+
+    CRC_ResetDR();
+    if (0 == ((uintptr_t)data & 3))
+    {
+        if (words)
+        {
+            CRC_CalcBlockCRC((uint32_t *)data, words);
+        }
+    }
+    else
+    {
+        for (uint16_t i = 0; i < words; i++)
+        {
+            memcpy(&word, data + i * 4, 4);
+            CRC_CalcCRC(word);
+        }
+    }
+    if (rest)
+    {
+        word = 0;
+        memcpy(&word, data + words * 4, rest);
+        CRC_CalcCRC(word);
+    }
+    return CRC_GetCRC();
+}
+
+/**
+ *  @brief 软件计算CRC32，结果与 BinFrame_CRC() 相同
+ *  @note  供上位机对照实现，或CRC外设被占用时使用
+ */
+uint32_t BinFrame_CRC_Soft(const uint8_t *data, uint16_t len)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint16_t i = 0; i < len; i += 4)
+    {
+        uint32_t word = 0;
+        for (uint8_t j = 0; j < 4 && (i + j) < len; j++)
+        {
+            word |= (uint32_t)data[i + j] << (8 * j); // 小端组字，末尾补0
+        }
+        crc ^= word;
+        for (uint8_t bit = 0; bit < 32; bit++)
+        {
+            crc = (crc & 0x80000000UL) ? ((crc << 1) ^ BINFRAME_CRC_POLY) : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ *  @brief 获取载荷类型的长度
+ *  @return 类型长度，RAW或未知类型返回0
+ */
+uint8_t BinFrame_Type_Size(uint8_t type)
+{
+    return (type < BINFRAME_TYPE_MAX) ? BinFrame_type_size[type] : 0;
+}
+
+/*
+ * @brief 复位解码器(统计计数不清零)
+ */
+void BinFrame_Decoder_Reset(BinFrame_Decoder_TpDef_struct *decoder)
+{
+    decoder->index = 0;
+}
+
+/*
+ * @brief 检查缓存中的候选帧
+ * @return 0 还需更多字节，1 完整且校验正确，-1 长度或类型错误，-2 CRC错误
+ */
+static int8_t BinFrame_Check(const BinFrame_Decoder_TpDef_struct *decoder)
+{
+    const uint8_t *buf = decoder->buf;
+
+    if (decoder->index < 2)
+    {
+        return 0;
+    }
+    if (buf[1] > BINFRAME_PAYLOAD_MAX)
+    {
+        return -1;
+    }
+    if (decoder->index < BINFRAME_HEADER_SIZE)
+    {
+        return 0;
+    }
+    if (buf[3] >= BINFRAME_TYPE_MAX || (BinFrame_type_size[buf[3]] && BinFrame_type_size[buf[3]] != buf[1]))
+    {
+        return -1;
+    }
+
+    uint8_t crc_pos = BINFRAME_HEADER_SIZE + buf[1];
+    if (decoder->index < crc_pos + BINFRAME_CRC_SIZE)
+    {
+        return 0;
+    }
+    uint32_t crc = (uint32_t)buf[crc_pos] | ((uint32_t)buf[crc_pos + 1] << 8) |
+                   ((uint32_t)buf[crc_pos + 2] << 16) | ((uint32_t)buf[crc_pos + 3] << 24);
+    return (BinFrame_CRC(buf, crc_pos) == crc) ? 1 : -2;
+}
+
+/*
+ * @brief 丢弃前count个字节，从其后第一个SOF开始重新对齐
+ */
+static void BinFrame_Resync(BinFrame_Decoder_TpDef_struct *decoder, uint8_t count)
+{
+    uint8_t p = count;
+
+    while (p < decoder->index && decoder->buf[p] != BINFRAME_SOF)
+    {
+        p++;
+    }
+    memmove(decoder->buf, decoder->buf + p, decoder->index - p);
+    decoder->index -= p;
+}
+
+/**
+ *  @brief 送入一个字节解帧
+ *  @param decoder 解码器
+ *  @param byte    收到的字节
+ *  @param frame   解出完整帧时写入此处
+ *  @return 解出一帧正确的帧返回true
+ *  @note  CRC或长度错误时丢弃当前帧头，从缓存中下一个SOF重新解析，不会漏掉紧随其后的正确帧
+ */
+bool BinFrame_Decode_Byte(BinFrame_Decoder_TpDef_struct *decoder, uint8_t byte, BinFrame_TpDef_struct *frame)
+{
+    if (0 == decoder->index && BINFRAME_SOF != byte)
+    {
+        return false; // 等待帧头
+    }
+    decoder->buf[decoder->index++] = byte;
+
+    while (1)
+    {
+        int8_t result = BinFrame_Check(decoder);
+        if (0 == result)
+        {
+            return false;
+        }
+        if (1 == result)
+        {
+            uint8_t len = decoder->buf[1];
+            frame->tag = decoder->buf[2];
+            frame->type = decoder->buf[3];
+            frame->len = len;
+            memcpy(frame->payload, decoder->buf + BINFRAME_HEADER_SIZE, len);
+            decoder->frame_count++;
+            BinFrame_Resync(decoder, BINFRAME_HEADER_SIZE + len + BINFRAME_CRC_SIZE);
+            return true;
+        }
+        if (-1 == result)
+        {
+            decoder->length_error_count++;
+        }
+        else
+        {
+            decoder->crc_error_count++;
+        }
+        BinFrame_Resync(decoder, 1);
+        if (0 == decoder->index)
+        {
+            return false;
+        }
+    }
+}
+
+/**
+ *  @brief 组帧
+ *  @param out     输出缓冲区，至少 BINFRAME_HEADER_SIZE+len+BINFRAME_CRC_SIZE 字节，4字节对齐时CRC计算更快
+ *  @param tag     标签
+ *  @param type    载荷类型
+ *  @param payload 载荷(数值类型按本机小端直接拷贝)
+ *  @param len     载荷长度，数值类型必须等于类型长度
+ *  @return 帧总长度，参数错误返回0
+ */
+uint16_t BinFrame_Encode(uint8_t *out, uint8_t tag, uint8_t type, const void *payload, uint8_t len)
+{
+    if (len > BINFRAME_PAYLOAD_MAX || type >= BINFRAME_TYPE_MAX ||
+        (BinFrame_type_size[type] && BinFrame_type_size[type] != len))
+    {
+        return 0;
+    }
+    out[0] = BINFRAME_SOF;
+    out[1] = len;
+    out[2] = tag;
+    out[3] = type;
+    memcpy(out + BINFRAME_HEADER_SIZE, payload, len);
+
+    uint8_t crc_pos = BINFRAME_HEADER_SIZE + len;
+    uint32_t crc = BinFrame_CRC(out, crc_pos);
+    out[crc_pos] = (uint8_t)crc;
+    out[crc_pos + 1] = (uint8_t)(crc >> 8);
+    out[crc_pos + 2] = (uint8_t)(crc >> 16);
+    out[crc_pos + 3] = (uint8_t)(crc >> 24);
+    return crc_pos + BINFRAME_CRC_SIZE;
+}
+
+/**
+ *  @brief 按类型取出载荷
+ *  @param frame 解出的帧
+ *  @param type  期望的载荷类型
+ *  @param value 存储位置，长度为类型长度(RAW为frame->len)
+ *  @return 类型一致返回true，否则不写入并返回false
+ */
+bool BinFrame_Get_Value(const BinFrame_TpDef_struct *frame, uint8_t type, void *value)
+{
+    if (frame->type != type)
+    {
+        return false;
+    }
+    memcpy(value, frame->payload, frame->len);
+    return true;
+}
+
+/**
+ *  @brief 依次取出批量帧中的条目
+ *  @param frame  批量帧(type为BINFRAME_TYPE_BATCH)
+ *  @param offset 载荷内的读取位置，首次调用前置0，每取出一条自动后移
+ *  @param item   取出的条目，value指向帧载荷内部
+ *  @return 1 取出一条，0 已取完，-1 格式错误(条目类型非法或越界)
+ */
+int8_t BinFrame_Batch_Next(const BinFrame_TpDef_struct *frame, uint8_t *offset, BinFrame_Item_TpDef_struct *item)
+{
+    if (*offset >= frame->len)
+    {
+        return 0;
+    }
+    if (frame->len - *offset < BINFRAME_ITEM_HEADER_SIZE)
+    {
+        return -1;
+    }
+    const uint8_t *p = frame->payload + *offset;
+    uint8_t size = BinFrame_Type_Size(p[1]);
+    if (0 == size || frame->len - *offset - BINFRAME_ITEM_HEADER_SIZE < size) // RAW、BATCH或未知类型不能作为条目
+    {
+        return -1;
+    }
+    item->tag = p[0];
+    item->type = p[1];
+    item->len = size;
+    item->value = p + BINFRAME_ITEM_HEADER_SIZE;
+    *offset += BINFRAME_ITEM_HEADER_SIZE + size;
+    return 1;
+}
+
+/**
+ *  @brief 向批量帧载荷追加一个条目
+ *  @param payload 批量帧载荷缓冲区，至少BINFRAME_PAYLOAD_MAX字节
+ *  @param offset  当前载荷长度
+ *  @param tag     标签
+ *  @param type    数值类型(不可为RAW或BATCH)
+ *  @param value   数值
+ *  @return 追加后的载荷长度，放不下或类型错误时返回offset不变
+ *  @note  组好后用 BinFrame_Encode(out, BINFRAME_TAG_BATCH, BINFRAME_TYPE_BATCH, payload, len) 组帧
+ */
+uint8_t BinFrame_Batch_Add(uint8_t *payload, uint8_t offset, uint8_t tag, uint8_t type, const void *value)
+{
+    uint8_t size = BinFrame_Type_Size(type);
+    if (0 == size || offset + BINFRAME_ITEM_HEADER_SIZE + size > BINFRAME_PAYLOAD_MAX)
+    {
+        return offset;
+    }
+    payload[offset] = tag;
+    payload[offset + 1] = type;
+    memcpy(payload + offset + BINFRAME_ITEM_HEADER_SIZE, value, size);
+    return offset + BINFRAME_ITEM_HEADER_SIZE + size;
+}
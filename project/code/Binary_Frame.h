@@ -0,0 +1,120 @@
+/*********************************************************************************************************************
+ * 本模块为二进制帧编解码，与具体传输无关(串口、USB CDC、无线串口均可使用)，CRC借助片上CRC外设(ch32v30x_crc)计算
+ * 简介：以长度前缀定帧、CRC32校验的二进制命令帧，载荷为带类型的数值，替代 ~}…}~ 文本帧
+ * 帧格式(小端)：
+ *    | SOF(0xA5) | LEN | TAG | TYPE | PAYLOAD[LEN] | CRC32[4] |
+ *    LEN  载荷字节数，0~BINFRAME_PAYLOAD_MAX
+ *    TAG  标签(参数或命令编号)
+ *    TYPE 载荷类型，见 BinFrame_Type_enum，数值类型的LEN必须等于类型长度
+ *    批量帧：TYPE为BINFRAME_TYPE_BATCH时，载荷为多条 | TAG | TYPE | VALUE[类型长度] | 依次排列(条目内不允许RAW和BATCH)，
+ *           TAG建议用BINFRAME_TAG_BATCH，接收方整批校验后一起写入，只回一个应答帧
+ *    请求帧：TYPE为BINFRAME_TYPE_REQUEST时，载荷为 | SEQ | VTYPE | VALUE[类型长度] |，TAG为目标标签，
+ *           接收方必回一个响应帧：TAG相同，TYPE为BINFRAME_TYPE_RESPONSE，载荷为 | SEQ | STATUS |(见 BinFrame_Status_enum)，
+ *           上位机按SEQ匹配响应，可连续发出多个请求(滑动窗口)而不必逐条等待
+ *    读取帧：TAG为BINFRAME_TAG_GET、TYPE为RAW时，载荷为要读取的标签列表，接收方回一个TAG为BINFRAME_TAG_GET的批量帧，
+ *           含各标签的当前数值(未登记或无存储变量的标签跳过)
+ *    CRC  覆盖 SOF~PAYLOAD，按4字节小端组成字，不足4字节的末尾补0，
+ *         多项式0x04C11DB7，初值0xFFFFFFFF，不反转、不异或(即CH32/STM32 CRC外设的默认算法)
+ * 实现：
+ *    BinFrame_Decode_Byte() 逐字节状态机解帧，CRC错误时从SOF后一字节重新搜索，可在乱码中自动同步；
+ *    BinFrame_Encode() 组帧，BinFrame_Get_Value() 按类型取出载荷。
+ * 用法：
+ * *.上电调用 BinFrame_Init() 打开CRC外设时钟
+ * *.每个传输通道一个 BinFrame_Decoder_TpDef_struct 解码器，收到的字节依次送入 BinFrame_Decode_Byte()
+ * *.BinFrame_CRC_Soft() 为与外设相同算法的软件实现，供上位机对照或无CRC外设时使用
+ * 注意：
+ * *.CRC外设是全局资源，BinFrame_CRC() 不可重入，不要在中断和主循环中同时使用
+ * *.数值类型按小端传输，F32为IEEE754单精度
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，长度前缀+硬件CRC32的二进制帧，带类型载荷
+ * 2026-10-19     Sxxx      V1.1，新增批量帧，一帧携带多个标签/数值
+ * 2026-10-19     Sxxx      V1.2，新增带序号的请求/响应帧
+ * 2026-10-19     Sxxx      V1.3，新增读取帧保留标签 BINFRAME_TAG_GET
+ ********************************************************************************************************************/
+#ifndef BINARY_FRAME_H
+#define BINARY_FRAME_H
+
+#include "stdint.h"
+#include <stdbool.h>
+
+#define BINFRAME_SOF 0xA5           // 帧头
+#define BINFRAME_PAYLOAD_MAX 64     // 最大载荷长度，自定义修改(不超过255)，批量帧每条F32参数占6字节
+#define BINFRAME_HEADER_SIZE 4      // SOF LEN TAG TYPE
+#define BINFRAME_CRC_SIZE 4         // CRC32
+#define BINFRAME_FRAME_MAX (BINFRAME_HEADER_SIZE + BINFRAME_PAYLOAD_MAX + BINFRAME_CRC_SIZE) // 最大帧长
+#define BINFRAME_ITEM_HEADER_SIZE 2 // 批量帧条目头 TAG TYPE
+#define BINFRAME_REQUEST_HEADER_SIZE 2 // 请求帧载荷头 SEQ VTYPE
+
+#define BINFRAME_TAG_GET 0xFD       // 保留标签：读取参数
+#define BINFRAME_TAG_BATCH 0xFE     // 保留标签：批量参数帧
+#define BINFRAME_TAG_ACK 0xFF       // 保留标签：应答帧
+
+// 载荷类型
+typedef enum
+{
+    BINFRAME_TYPE_RAW = 0, // 原始字节，长度不限
+    BINFRAME_TYPE_U8,
+    BINFRAME_TYPE_I8,
+    BINFRAME_TYPE_U16,
+    BINFRAME_TYPE_I16,
+    BINFRAME_TYPE_U32,
+    BINFRAME_TYPE_I32,
+    BINFRAME_TYPE_F32,
+    BINFRAME_TYPE_BATCH,    // 批量条目，长度不限
+    BINFRAME_TYPE_REQUEST,  // 带序号的请求，SEQ VTYPE VALUE
+    BINFRAME_TYPE_RESPONSE, // 请求的响应，SEQ STATUS
+    BINFRAME_TYPE_MAX,
+} BinFrame_Type_enum;
+
+// 响应状态
+typedef enum
+{
+    BINFRAME_STATUS_ACK = 0,         // 已执行
+    BINFRAME_STATUS_NACK_UNKNOWN,    // 标签未登记
+    BINFRAME_STATUS_NACK_TYPE,       // 数值类型与登记的不一致
+    BINFRAME_STATUS_NACK_REJECTED,   // 命令处理函数拒绝(如电机忙)
+    BINFRAME_STATUS_NACK_FORMAT,     // 请求载荷格式错误
+} BinFrame_Status_enum;
+
+// 解出的一帧
+typedef struct
+{
+    uint8_t tag;                                                 // 标签
+    uint8_t type;                                                // 载荷类型
+    uint8_t len;                                                 // 载荷长度
+    uint8_t payload[BINFRAME_PAYLOAD_MAX] __attribute__((aligned(4))); // 载荷
+} BinFrame_TpDef_struct;
+
+// 批量帧中的一个条目(指向帧载荷内部，不拷贝)
+typedef struct
+{
+    uint8_t tag;          // 标签
+    uint8_t type;         // 数值类型
+    uint8_t len;          // 数值长度
+    const uint8_t *value; // 数值起始位置
+} BinFrame_Item_TpDef_struct;
+
+// 解码器，每个传输通道一个
+typedef struct
+{
+    uint8_t index;                                         // 已接收字节数，私有
+    uint8_t buf[BINFRAME_FRAME_MAX] __attribute__((aligned(4))); // 帧缓存(4字节对齐，CRC外设按字读取)，私有
+    uint32_t frame_count;                                  // 正确帧计数
+    uint32_t crc_error_count;                              // CRC错误计数
+    uint32_t length_error_count;                           // 长度或类型错误计数
+} BinFrame_Decoder_TpDef_struct;
+
+void BinFrame_Init(void);
+uint32_t BinFrame_CRC(const uint8_t *data, uint16_t len);
+uint32_t BinFrame_CRC_Soft(const uint8_t *data, uint16_t len);
+uint8_t BinFrame_Type_Size(uint8_t type);
+void BinFrame_Decoder_Reset(BinFrame_Decoder_TpDef_struct *decoder);
+bool BinFrame_Decode_Byte(BinFrame_Decoder_TpDef_struct *decoder, uint8_t byte, BinFrame_TpDef_struct *frame);
+uint16_t BinFrame_Encode(uint8_t *out, uint8_t tag, uint8_t type, const void *payload, uint8_t len);
+bool BinFrame_Get_Value(const BinFrame_TpDef_struct *frame, uint8_t type, void *value);
+int8_t BinFrame_Batch_Next(const BinFrame_TpDef_struct *frame, uint8_t *offset, BinFrame_Item_TpDef_struct *item);
+uint8_t BinFrame_Batch_Add(uint8_t *payload, uint8_t offset, uint8_t tag, uint8_t type, const void *value);
+
+#endif // BINARY_FRAME_H
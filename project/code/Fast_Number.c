@@ -0,0 +1,669 @@
+/*********************************************************************************************************************
+ * 快速数值解析/格式化，用法见 Fast_Number.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，查表的整数/浮点/定点解析与格式化，轻量 vsnprintf
+ * 2026-10-19     Sxxx      V1.1，格式化支持 * 宽度与 .* 精度(从参数列表读取，负宽度表示左对齐，负精度视为未指定)
+ ********************************************************************************************************************/
+#include "Fast_Number.h"
+#include <stddef.h>
+
+#define FASTNUM_MANTISSA_DIGITS 9 // 尾数最多累加的有效数字位数，保证不超过32位
+#define FASTNUM_EXP_LIMIT 38      // float 十进制指数范围
+
+// 10的幂，整数缩放用
+static const uint32_t FastNum_pow10_u32[10] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+};
+
+// 10的幂，浮点缩放用，更大的指数分多次乘除
+static const float FastNum_pow10_f32[11] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+// 两位十进制数字表，格式化时一次写两位
+static const char FastNum_digit_pairs[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9',
+};
+
+static const char FastNum_hex_lower[16] = "0123456789abcdef";
+static const char FastNum_hex_upper[16] = "0123456789ABCDEF";
+
+/*
+ * @brief 跳过空白，读取符号
+ * @return 负数返回true
+ */
+static bool FastNum_Sign(const char **p)
+{
+    while (' ' == **p || '\t' == **p)
+    {
+        (*p)++;
+    }
+    if ('-' == **p)
+    {
+        (*p)++;
+        return true;
+    }
+    if ('+' == **p)
+    {
+        (*p)++;
+    }
+    return false;
+}
+
+/**
+ *  @brief 解析无符号十进制整数
+ *  @param str 字符串，允许前导空白和'+'
+ *  @param end 返回第一个未解析字符的位置，可传NULL
+ *  @return 数值，超过32位时饱和为0xFFFFFFFF
+ */
+uint32_t FastNum_Parse_Uint(const char *str, const char **end)
+{
+    const char *p = str;
+    uint32_t value = 0;
+    bool overflow = false;
+
+    FastNum_Sign(&p);
+    while (*p >= '0' && *p <= '9')
+    {
+        uint8_t digit = (uint8_t)(*p++ - '0');
+        if (value > (0xFFFFFFFFUL - digit) / 10)
+        {
+            overflow = true;
+        }
+        value = value * 10 + digit;
+    }
+    if (end != NULL)
+    {
+        *end = p;
+    }
+    return overflow ? 0xFFFFFFFFUL : value;
+}
+
+/**
+ *  @brief 解析有符号十进制整数(替代atoi)
+ *  @param str 字符串，允许前导空白和符号
+ *  @param end 返回第一个未解析字符的位置，可传NULL
+ *  @return 数值，溢出时饱和到INT32_MAX/INT32_MIN
+ */
+int32_t FastNum_Parse_Int(const char *str, const char **end)
+{
+    const char *p = str;
+    bool negative = FastNum_Sign(&p);
+    uint32_t magnitude = FastNum_Parse_Uint(p, end);
+
+    if (negative)
+    {
+        return (magnitude >= 0x80000000UL) ? INT32_MIN : -(int32_t)magnitude;
+    }
+    return (magnitude > 0x7FFFFFFFUL) ? INT32_MAX : (int32_t)magnitude;
+}
+
+/**
+ *  @brief 解析浮点数(替代atof)，支持小数点和e/E指数
+ *  @param str 字符串，允许前导空白和符号，如 "-1.25"、"3e-2"
+ *  @param end 返回第一个未解析字符的位置，可传NULL
+ *  @return 数值，最多取9位有效数字
+ *  @note  尾数按整数累加，最后按10的幂表缩放一次
+ */
+float FastNum_Parse_Float(const char *str, const char **end)
+{
+    const char *p = str;
+    bool negative = FastNum_Sign(&p);
+    uint32_t mantissa = 0;
+    uint8_t digits = 0;
+    int16_t exponent = 0;
+    const char *digits_start = p;
+
+    while (*p >= '0' && *p <= '9')
+    {
+        if (digits < FASTNUM_MANTISSA_DIGITS)
+        {
+            mantissa = mantissa * 10 + (uint8_t)(*p - '0');
+            if (mantissa)
+            {
+                digits++; // 前导0不计入有效数字
+            }
+        }
+        else
+        {
+            exponent++; // 超出的整数位只计指数
+        }
+        p++;
+    }
+    if ('.' == *p)
+    {
+        p++;
+        while (*p >= '0' && *p <= '9')
+        {
+            if (digits < FASTNUM_MANTISSA_DIGITS)
+            {
+                mantissa = mantissa * 10 + (uint8_t)(*p - '0');
+                exponent--;
+                if (mantissa)
+                {
+                    digits++;
+                }
+            }
+            p++; // 超出的小数位忽略
+        }
+    }
+    if (('e' == *p || 'E' == *p) && p != digits_start)
+    {
+        const char *q = p + 1;
+        if ('+' == *q || '-' == *q)
+        {
+            q++;
+        }
+        if (*q >= '0' && *q <= '9') // 有指数数字才接受
+        {
+            int32_t exp = FastNum_Parse_Int(p + 1, &p);
+            exponent += (int16_t)((exp > 100) ? 100 : ((exp < -100) ? -100 : exp));
+        }
+    }
+    if (end != NULL)
+    {
+        *end = p;
+    }
+
+    float value = (float)mantissa;
+    if (0 == mantissa)
+    {
+        return negative ? -0.0f : 0.0f;
+    }
+    if (exponent > FASTNUM_EXP_LIMIT)
+    {
+        exponent = FASTNUM_EXP_LIMIT + 1; // 结果溢出为inf
+    }
+    if (exponent < -FASTNUM_EXP_LIMIT - FASTNUM_MANTISSA_DIGITS)
+    {
+        return negative ? -0.0f : 0.0f;
+    }
+    while (exponent > 10)
+    {
+        value *= FastNum_pow10_f32[10];
+        exponent -= 10;
+    }
+    while (exponent < -10)
+    {
+        value /= FastNum_pow10_f32[10];
+        exponent += 10;
+    }
+    if (exponent > 0)
+    {
+        value *= FastNum_pow10_f32[exponent];
+    }
+    else if (exponent < 0)
+    {
+        value /= FastNum_pow10_f32[-exponent]; // 除以精确的10的幂，比乘以0.1^n误差小
+    }
+    return negative ? -value : value;
+}
+
+/**
+ *  @brief 解析十进制小数为定点数(按 decimals 位小数放大的整数)，全程整数运算
+ *  @param str      字符串，如 "-1.255"
+ *  @param decimals 小数位数(0~9)，如 3 时 "-1.255" 得到 -1255
+ *  @param end      返回第一个未解析字符的位置，可传NULL
+ *  @return 定点数，多余的小数位四舍五入，溢出时饱和到INT32_MAX/INT32_MIN
+ */
+int32_t FastNum_Parse_Fixed(const char *str, uint8_t decimals, const char **end)
+{
+    const char *p = str;
+    bool negative = FastNum_Sign(&p);
+    uint32_t limit = negative ? 0x80000000UL : 0x7FFFFFFFUL;
+    uint32_t value = 0;
+    bool overflow = false;
+
+    if (decimals > 9)
+    {
+        decimals = 9;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        uint8_t digit = (uint8_t)(*p++ - '0');
+        if (value > (limit - digit) / 10)
+        {
+            overflow = true;
+        }
+        value = value * 10 + digit;
+    }
+    uint8_t frac = 0;
+    bool round_up = false;
+    if ('.' == *p)
+    {
+        p++;
+        while (*p >= '0' && *p <= '9')
+        {
+            uint8_t digit = (uint8_t)(*p++ - '0');
+            if (frac < decimals)
+            {
+                if (value > (limit - digit) / 10)
+                {
+                    overflow = true;
+                }
+                value = value * 10 + digit;
+                frac++;
+            }
+            else if (frac == decimals)
+            {
+                round_up = (digit >= 5); // 只看第一位多余的小数
+                frac++;
+            }
+        }
+    }
+    if (frac > decimals)
+    {
+        frac = decimals;
+    }
+    for (; frac < decimals; frac++) // 小数位不足时补0
+    {
+        if (value > limit / 10)
+        {
+            overflow = true;
+        }
+        value *= 10;
+    }
+    if (round_up && value < limit)
+    {
+        value++;
+    }
+    if (end != NULL)
+    {
+        *end = p;
+    }
+    if (overflow || value > limit)
+    {
+        value = limit;
+    }
+    return negative ? (int32_t)(0U - value) : (int32_t)value;
+}
+
+/**
+ *  @brief 格式化无符号整数
+ *  @param out 输出缓冲区，至少 FASTNUM_INT_MAX_LENGTH 字节
+ *  @return 字符数(不含'\0')
+ */
+uint8_t FastNum_Format_Uint(char *out, uint32_t value)
+{
+    char temp[FASTNUM_INT_MAX_LENGTH];
+    uint8_t pos = sizeof(temp);
+
+    while (value >= 100)
+    {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        temp[--pos] = FastNum_digit_pairs[pair + 1];
+        temp[--pos] = FastNum_digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        temp[--pos] = FastNum_digit_pairs[value * 2 + 1];
+        temp[--pos] = FastNum_digit_pairs[value * 2];
+    }
+    else
+    {
+        temp[--pos] = (char)('0' + value);
+    }
+
+    uint8_t len = sizeof(temp) - pos;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        out[i] = temp[pos + i];
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/**
+ *  @brief 格式化有符号整数
+ *  @param out 输出缓冲区，至少 FASTNUM_INT_MAX_LENGTH 字节
+ *  @return 字符数(不含'\0')
+ */
+uint8_t FastNum_Format_Int(char *out, int32_t value)
+{
+    if (value < 0)
+    {
+        out[0] = '-';
+        return 1 + FastNum_Format_Uint(out + 1, 0U - (uint32_t)value);
+    }
+    return FastNum_Format_Uint(out, (uint32_t)value);
+}
+
+/**
+ *  @brief 格式化十六进制整数(不带0x前缀)
+ *  @param out   输出缓冲区，至少9字节
+ *  @param upper true 使用大写字母
+ *  @return 字符数(不含'\0')
+ */
+uint8_t FastNum_Format_Hex(char *out, uint32_t value, bool upper)
+{
+    const char *table = upper ? FastNum_hex_upper : FastNum_hex_lower;
+    uint8_t len = 1;
+
+    while (len < 8 && (value >> (len * 4)))
+    {
+        len++;
+    }
+    for (uint8_t i = 0; i < len; i++)
+    {
+        out[len - 1 - i] = table[(value >> (i * 4)) & 0x0F];
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/*
+ * @brief 写入固定位数的小数部分(高位补0)
+ */
+static uint8_t FastNum_Format_Fraction(char *out, uint32_t frac, uint8_t decimals)
+{
+    for (uint8_t i = decimals; i > 0; i--)
+    {
+        out[i - 1] = (char)('0' + frac % 10);
+        frac /= 10;
+    }
+    out[decimals] = '\0';
+    return decimals;
+}
+
+/**
+ *  @brief 格式化浮点数(定点小数形式)
+ *  @param out      输出缓冲区，至少 FASTNUM_FLOAT_MAX_LENGTH 字节
+ *  @param decimals 小数位数，超过 FASTNUM_FLOAT_MAX_DECIMALS 按其处理
+ *  @return 字符数(不含'\0')
+ *  @note  四舍五入到指定位数；nan输出"nan"，整数部分超过32位输出"inf"
+ */
+uint8_t FastNum_Format_Float(char *out, float value, uint8_t decimals)
+{
+    uint8_t len = 0;
+
+    if (decimals > FASTNUM_FLOAT_MAX_DECIMALS)
+    {
+        decimals = FASTNUM_FLOAT_MAX_DECIMALS;
+    }
+    if (value != value)
+    {
+        out[0] = 'n', out[1] = 'a', out[2] = 'n', out[3] = '\0';
+        return 3;
+    }
+    if (value < 0.0f)
+    {
+        out[len++] = '-';
+        value = -value;
+    }
+    if (value >= 4294967296.0f)
+    {
+        out[len] = 'i', out[len + 1] = 'n', out[len + 2] = 'f', out[len + 3] = '\0';
+        return len + 3;
+    }
+
+    uint32_t integer = (uint32_t)value;
+    uint32_t scale = FastNum_pow10_u32[decimals];
+    uint32_t frac = (uint32_t)((value - (float)integer) * (float)scale + 0.5f);
+    if (frac >= scale) // 小数部分进位
+    {
+        frac -= scale;
+        if (integer == 0xFFFFFFFFUL)
+        {
+            out[len] = 'i', out[len + 1] = 'n', out[len + 2] = 'f', out[len + 3] = '\0';
+            return len + 3;
+        }
+        integer++;
+    }
+    len += FastNum_Format_Uint(out + len, integer);
+    if (decimals)
+    {
+        out[len++] = '.';
+        len += FastNum_Format_Fraction(out + len, frac, decimals);
+    }
+    return len;
+}
+
+/**
+ *  @brief 格式化定点数(按 decimals 位小数放大的整数)，全程整数运算
+ *  @param out      输出缓冲区，至少 FASTNUM_INT_MAX_LENGTH+1 字节
+ *  @param decimals 小数位数(0~9)，如 3 时 -1255 输出 "-1.255"
+ *  @return 字符数(不含'\0')
+ */
+uint8_t FastNum_Format_Fixed(char *out, int32_t value, uint8_t decimals)
+{
+    uint8_t len = 0;
+    uint32_t magnitude = (uint32_t)value;
+
+    if (decimals > 9)
+    {
+        decimals = 9;
+    }
+    if (value < 0)
+    {
+        out[len++] = '-';
+        magnitude = 0U - magnitude;
+    }
+    len += FastNum_Format_Uint(out + len, magnitude / FastNum_pow10_u32[decimals]);
+    if (decimals)
+    {
+        out[len++] = '.';
+        len += FastNum_Format_Fraction(out + len, magnitude % FastNum_pow10_u32[decimals], decimals);
+    }
+    return len;
+}
+
+/*
+ * @brief 向输出缓冲区追加一个字符，超出部分只计数
+ */
+static inline void FastNum_Put(char *out, uint16_t size, uint16_t *pos, char c)
+{
+    if (*pos + 1 < size)
+    {
+        out[*pos] = c;
+    }
+    (*pos)++;
+}
+
+/*
+ * @brief 按宽度、对齐追加一段已格式化的字符串
+ * @param sign_len 开头符号字符数，补0时0补在符号之后
+ */
+static void FastNum_Put_Field(char *out, uint16_t size, uint16_t *pos, const char *str, uint16_t len, uint8_t width, bool left, bool zero, uint8_t sign_len)
+{
+    uint16_t pad = (width > len) ? width - len : 0;
+    uint16_t i = 0;
+
+    if (!left && !zero)
+    {
+        for (; pad; pad--)
+        {
+            FastNum_Put(out, size, pos, ' ');
+        }
+    }
+    for (; i < sign_len; i++)
+    {
+        FastNum_Put(out, size, pos, str[i]);
+    }
+    if (!left && zero)
+    {
+        for (; pad; pad--)
+        {
+            FastNum_Put(out, size, pos, '0');
+        }
+    }
+    for (; i < len; i++)
+    {
+        FastNum_Put(out, size, pos, str[i]);
+    }
+    for (; pad; pad--)
+    {
+        FastNum_Put(out, size, pos, ' ');
+    }
+}
+
+/**
+ *  @brief 轻量格式化输出(替代vsnprintf)
+ *  @param out    输出缓冲区
+ *  @param size   缓冲区大小，输出总以'\0'结尾，放不下的部分截断
+ *  @param format 格式字符串，支持的格式符见 Fast_Number.h
+ *  @param arg    参数列表
+ *  @return 不截断时应输出的字符数(不含'\0')，大于等于size表示被截断
+ *  @note  不支持的格式符原样输出
+ */
+uint16_t FastNum_Vsnprintf(char *out, uint16_t size, const char *format, va_list arg)
+{
+    char temp[FASTNUM_FLOAT_MAX_LENGTH];
+    uint16_t pos = 0;
+
+    for (const char *p = format; *p != '\0'; p++)
+    {
+        if ('%' != *p)
+        {
+            FastNum_Put(out, size, &pos, *p);
+            continue;
+        }
+        const char *spec = p++;
+        bool left = false;
+        bool zero = false;
+        uint8_t width = 0;
+        int8_t precision = -1;
+        bool is_long = false;
+
+        for (;; p++) // 标志
+        {
+            if ('-' == *p)
+            {
+                left = true;
+            }
+            else if ('0' == *p)
+            {
+                zero = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+        if ('*' == *p) // 宽度由参数给出，负数表示左对齐
+        {
+            int value = va_arg(arg, int);
+            if (value < 0)
+            {
+                left = true;
+                value = -value;
+            }
+            width = (uint8_t)((value > 255) ? 255 : value);
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') // 宽度
+        {
+            width = (uint8_t)(width * 10 + (*p++ - '0'));
+        }
+        if ('.' == *p) // 精度
+        {
+            precision = 0;
+            p++;
+            if ('*' == *p) // 精度由参数给出，负数视为未指定
+            {
+                int value = va_arg(arg, int);
+                precision = (int8_t)((value < 0) ? -1 : ((value > 127) ? 127 : value));
+                p++;
+            }
+            while (*p >= '0' && *p <= '9')
+            {
+                precision = (int8_t)(precision * 10 + (*p++ - '0'));
+            }
+        }
+        while ('l' == *p || 'h' == *p) // 长度修饰
+        {
+            is_long |= ('l' == *p);
+            p++;
+        }
+
+        uint16_t len = 0;
+        uint8_t sign_len = 0;
+        const char *str = temp;
+        switch (*p)
+        {
+        case 'd':
+        case 'i':
+        {
+            int32_t value = is_long ? (int32_t)va_arg(arg, long) : (int32_t)va_arg(arg, int);
+            len = FastNum_Format_Int(temp, value);
+            sign_len = (value < 0);
+            break;
+        }
+        case 'u':
+            len = FastNum_Format_Uint(temp, is_long ? (uint32_t)va_arg(arg, unsigned long) : (uint32_t)va_arg(arg, unsigned int));
+            break;
+        case 'x':
+        case 'X':
+            len = FastNum_Format_Hex(temp, is_long ? (uint32_t)va_arg(arg, unsigned long) : (uint32_t)va_arg(arg, unsigned int), 'X' == *p);
+            break;
+        case 'f':
+        case 'F':
+        {
+            float value = (float)va_arg(arg, double); // 可变参数中float提升为double，转回float后按单精度处理
+            len = FastNum_Format_Float(temp, value, (precision < 0) ? 6 : (uint8_t)precision);
+            sign_len = ('-' == temp[0]);
+            break;
+        }
+        case 'c':
+            temp[0] = (char)va_arg(arg, int);
+            len = 1;
+            zero = false;
+            break;
+        case 's':
+            str = va_arg(arg, const char *);
+            if (NULL == str)
+            {
+                str = "(null)";
+            }
+            while (str[len] != '\0' && (precision < 0 || len < (uint16_t)precision))
+            {
+                len++;
+            }
+            zero = false;
+            break;
+        case '%':
+            temp[0] = '%';
+            len = 1;
+            break;
+        default: // 不支持的格式符原样输出
+            for (; spec <= p && *spec != '\0'; spec++)
+            {
+                FastNum_Put(out, size, &pos, *spec);
+            }
+            if ('\0' == *p)
+            {
+                p--; // 格式串在格式符中间结束
+            }
+            continue;
+        }
+        FastNum_Put_Field(out, size, &pos, str, len, width, left, zero, sign_len);
+    }
+    if (size)
+    {
+        out[(pos < size) ? pos : size - 1] = '\0';
+    }
+    return pos;
+}
+
+/**
+ *  @brief 轻量格式化输出(替代snprintf)，参数与返回值同 FastNum_Vsnprintf()
+ */
+uint16_t FastNum_Snprintf(char *out, uint16_t size, const char *format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    uint16_t len = FastNum_Vsnprintf(out, size, format, arg);
+    va_end(arg);
+    return len;
+}
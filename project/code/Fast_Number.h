@@ -0,0 +1,44 @@
+/*********************************************************************************************************************
+ * 本模块为不分配内存的快速数值解析/格式化，替代调试与协议路径上的 atof/atoi/vsnprintf(newlib)
+ * 简介：整数、浮点数、定点数(按十进制小数位缩放的整数)的解析与格式化，以及只支持常用格式符的 FastNum_Vsnprintf()
+ * 实现：
+ *    解析：十进制数字累加到32位整数尾数(最多9位有效数字)，再按10的幂表缩放一次，不逐位做浮点乘法；
+ *    格式化：整数按两位一组查表("00"~"99")从低位向高位写，浮点数拆成整数部分和按小数位数缩放后的小数部分分别按整数输出；
+ *    全部使用调用者提供的缓冲区，栈占用固定(不超过 FASTNUM_INT_MAX_LENGTH 字节的临时区)，不使用 double 运算和 malloc。
+ * 用法：
+ * *.FastNum_Parse_Int()/FastNum_Parse_Float()/FastNum_Parse_Fixed() 解析字符串，end 返回解析结束位置(可传NULL)
+ * *.FastNum_Format_Int()/_Uint()/_Hex()/_Float()/_Fixed() 写入字符串并返回长度(不含结尾'\0'，会写结尾'\0')
+ * *.FastNum_Vsnprintf()/FastNum_Snprintf() 支持 %d %i %u %x %X %c %s %f %%，标志'-'、'0'，宽度(N或*)，精度(.N或.*，%f默认6位)，长度修饰 l/h/hh(忽略)
+ * 注意：
+ * *.%f 的参数按 float 精度处理：整数部分超过 4294967295 的输出 inf，小数位数最多 FASTNUM_FLOAT_MAX_DECIMALS 位
+ * *.解析溢出时饱和到类型最大/最小值
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，查表的整数/浮点/定点解析与格式化，轻量 vsnprintf
+ * 2026-10-19     Sxxx      V1.1，格式化支持 * 宽度与 .* 精度(从参数列表读取，负宽度表示左对齐，负精度视为未指定)
+ ********************************************************************************************************************/
+#ifndef FAST_NUMBER_H
+#define FAST_NUMBER_H
+
+#include "stdint.h"
+#include <stdbool.h>
+#include <stdarg.h>
+
+#define FASTNUM_INT_MAX_LENGTH 12      // 32位整数格式化后的最大长度(含符号和'\0')
+#define FASTNUM_FLOAT_MAX_DECIMALS 6   // 浮点数格式化最多小数位数
+#define FASTNUM_FLOAT_MAX_LENGTH (FASTNUM_INT_MAX_LENGTH + 1 + FASTNUM_FLOAT_MAX_DECIMALS) // 浮点数格式化后的最大长度(含'\0')
+
+int32_t FastNum_Parse_Int(const char *str, const char **end);
+uint32_t FastNum_Parse_Uint(const char *str, const char **end);
+float FastNum_Parse_Float(const char *str, const char **end);
+int32_t FastNum_Parse_Fixed(const char *str, uint8_t decimals, const char **end);
+uint8_t FastNum_Format_Uint(char *out, uint32_t value);
+uint8_t FastNum_Format_Int(char *out, int32_t value);
+uint8_t FastNum_Format_Hex(char *out, uint32_t value, bool upper);
+uint8_t FastNum_Format_Float(char *out, float value, uint8_t decimals);
+uint8_t FastNum_Format_Fixed(char *out, int32_t value, uint8_t decimals);
+uint16_t FastNum_Vsnprintf(char *out, uint16_t size, const char *format, va_list arg);
+uint16_t FastNum_Snprintf(char *out, uint16_t size, const char *format, ...);
+
+#endif // FAST_NUMBER_H
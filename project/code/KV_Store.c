@@ -0,0 +1,321 @@
+/*********************************************************************************************************************
+ * 片内Flash日志结构键值存储，用法见 KV_Store.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，多扇区轮流写入的日志结构键值存储，RAM索引，回收与掉电恢复
+ ********************************************************************************************************************/
+#include "KV_Store.h"
+#include "Binary_Frame.h"
+#include "zf_driver_flash.h"
+#include "string.h"
+
+#define KV_STORE_HEADER_SIZE 12 // 扇区头 MAGIC 序号 CRC
+#define KV_STORE_RECORD_SIZE(len) (4 + (((uint16_t)(len) + 3) & ~3u) + 4)
+#define KV_STORE_SECTOR_ADDR(i) (FLASH_BASE_ADDR + FLASH_SECTION_SIZE * (KV_STORE_SECTOR_FIRST + (i)))
+#define KV_STORE_NO_SECTOR 0xFF
+
+// 所有键的最新记录要能放进一个扇区，回收时才搬得下
+typedef char KV_Store_live_data_must_fit_one_sector[(KV_STORE_KEY_MAX * KV_STORE_RECORD_SIZE(KV_STORE_VALUE_MAX) <= FLASH_SECTION_SIZE - KV_STORE_HEADER_SIZE) ? 1 : -1];
+typedef char KV_Store_needs_two_sectors[(KV_STORE_SECTOR_COUNT >= 2) ? 1 : -1];
+
+static uintptr_t KV_index[KV_STORE_KEY_MAX];      // 各键最新记录的地址，0为没有
+static bool KV_valid[KV_STORE_SECTOR_COUNT];      // 扇区头有效(在用)
+static uint32_t KV_sequence[KV_STORE_SECTOR_COUNT]; // 扇区序号
+static uint8_t KV_active = KV_STORE_NO_SECTOR;    // 当前写入扇区
+static uint16_t KV_offset = 0;                    // 当前扇区下一条记录的字节偏移
+
+/*
+ * @brief 检查扇区头
+ * @return 有效返回true，并取出序号
+ */
+static bool KV_Header_Valid(uint8_t sector, uint32_t *sequence)
+{
+    const volatile uint32_t *p = (const volatile uint32_t *)KV_STORE_SECTOR_ADDR(sector);
+    if (p[0] != KV_STORE_MAGIC || p[2] != BinFrame_CRC((const uint8_t *)p, 8))
+    {
+        return false;
+    }
+    *sequence = p[1];
+    return true;
+}
+
+/*
+ * @brief 检查一条记录
+ * @param room： 扇区内剩余字节数
+ * @return 有效返回记录字节数，否则返回0
+ */
+static uint16_t KV_Record_Valid(const volatile uint32_t *p, uint16_t room)
+{
+    uint32_t head = p[0];
+    uint8_t key = (uint8_t)(head >> 8);
+    uint8_t len = (uint8_t)(head >> 16);
+    if ((head & 0xFF) != KV_STORE_RECORD_MARK || key >= KV_STORE_KEY_MAX || 0 == len || len > KV_STORE_VALUE_MAX)
+    {
+        return 0;
+    }
+    uint16_t size = KV_STORE_RECORD_SIZE(len);
+    if (size > room || p[size / 4 - 1] != BinFrame_CRC((const uint8_t *)p, size - 4))
+    {
+        return 0;
+    }
+    return size;
+}
+
+/*
+ * @brief 按顺序重放一个扇区的记录，更新索引
+ * @return 扇区中第一个未写位置的偏移
+ */
+static uint16_t KV_Replay(uint8_t sector)
+{
+    uintptr_t base = KV_STORE_SECTOR_ADDR(sector);
+    uint16_t offset = KV_STORE_HEADER_SIZE;
+    while (offset + 4 <= FLASH_SECTION_SIZE)
+    {
+        const volatile uint32_t *p = (const volatile uint32_t *)(base + offset);
+        if (FLASH_ERASED_WORD == p[0])
+        {
+            break; // 日志末尾
+        }
+        uint16_t size = KV_Record_Valid(p, FLASH_SECTION_SIZE - offset);
+        if (0 == size)
+        {
+            offset += 4; // 写一半掉电的记录，逐字跳过
+            continue;
+        }
+        KV_index[(uint8_t)(p[0] >> 8)] = base + offset;
+        offset += size;
+    }
+    return offset;
+}
+
+/*
+ * @brief 在当前扇区追加一条记录，不换扇区
+ * @return 成功返回true；空间不够返回false
+ */
+static bool KV_Append(uint8_t key, const void *value, uint8_t len)
+{
+    uint32_t record[(KV_STORE_RECORD_SIZE(KV_STORE_VALUE_MAX)) / 4];
+    uint16_t size = KV_STORE_RECORD_SIZE(len);
+
+    memset(record, 0, sizeof(record));
+    record[0] = KV_STORE_RECORD_MARK | ((uint32_t)key << 8) | ((uint32_t)len << 16);
+    memcpy(&record[1], value, len);
+    record[size / 4 - 1] = BinFrame_CRC((const uint8_t *)record, size - 4);
+
+    while (KV_offset + size <= FLASH_SECTION_SIZE)
+    {
+        uint16_t offset = KV_offset;
+        if (0 == flash_write_words(KV_STORE_SECTOR_FIRST + KV_active, offset, (const uint32 *)record, size / 4))
+        {
+            KV_offset += size;
+            KV_index[key] = KV_STORE_SECTOR_ADDR(KV_active) + offset;
+            return true;
+        }
+        KV_offset += 4; // 目标位置不是擦除状态(之前写一半的记录)，往后找
+    }
+    return false;
+}
+
+/*
+ * @brief 启用一个扇区：确保已擦除后写扇区头
+ */
+static bool KV_Open_Sector(uint8_t sector, uint32_t sequence)
+{
+    const volatile uint32_t *p = (const volatile uint32_t *)KV_STORE_SECTOR_ADDR(sector);
+    uint32_t header[3];
+
+    for (uint16_t i = 0; i < FLASH_SECTION_SIZE / 4; i++)
+    {
+        if (p[i] != FLASH_ERASED_WORD)
+        {
+            if (flash_erase_sector(KV_STORE_SECTOR_FIRST + sector, 0))
+            {
+                return false;
+            }
+            break;
+        }
+    }
+    header[0] = KV_STORE_MAGIC;
+    header[1] = sequence;
+    header[2] = BinFrame_CRC((const uint8_t *)header, 8);
+    if (flash_write_words(KV_STORE_SECTOR_FIRST + sector, 0, (const uint32 *)header, 3))
+    {
+        return false;
+    }
+    KV_valid[sector] = true;
+    KV_sequence[sector] = sequence;
+    KV_active = sector;
+    KV_offset = KV_STORE_HEADER_SIZE;
+    return true;
+}
+
+/*
+ * @brief 在用扇区中(除当前扇区外)序号最小的
+ */
+static uint8_t KV_Oldest(void)
+{
+    uint8_t oldest = KV_STORE_NO_SECTOR;
+    for (uint8_t i = 0; i < KV_STORE_SECTOR_COUNT; i++)
+    {
+        if (!KV_valid[i] || i == KV_active)
+        {
+            continue;
+        }
+        if (KV_STORE_NO_SECTOR == oldest || (int32_t)(KV_sequence[i] - KV_sequence[oldest]) < 0)
+        {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+/*
+ * @brief 回收：把最旧扇区中仍是最新值的记录搬到当前扇区，再擦除最旧扇区
+ */
+static bool KV_Collect(void)
+{
+    uint8_t victim = KV_Oldest();
+    if (KV_STORE_NO_SECTOR == victim)
+    {
+        return true;
+    }
+    uintptr_t begin = KV_STORE_SECTOR_ADDR(victim);
+    for (uint8_t key = 0; key < KV_STORE_KEY_MAX; key++)
+    {
+        uintptr_t addr = KV_index[key];
+        if (addr < begin || addr >= begin + FLASH_SECTION_SIZE)
+        {
+            continue;
+        }
+        const volatile uint32_t *p = (const volatile uint32_t *)addr;
+        if (!KV_Append(key, (const void *)(p + 1), (uint8_t)(p[0] >> 16)))
+        {
+            return false;
+        }
+    }
+    if (flash_erase_sector(KV_STORE_SECTOR_FIRST + victim, 0))
+    {
+        return false;
+    }
+    KV_valid[victim] = false;
+    return true;
+}
+
+/*
+ * @brief 当前扇区写满：按顺序启用下一个空闲扇区并回收最旧扇区
+ */
+static bool KV_Rotate(void)
+{
+    for (uint8_t i = 1; i < KV_STORE_SECTOR_COUNT; i++)
+    {
+        uint8_t sector = (KV_active + i) % KV_STORE_SECTOR_COUNT;
+        if (!KV_valid[sector])
+        {
+            return KV_Open_Sector(sector, KV_sequence[KV_active] + 1) && KV_Collect();
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 挂载：按序号从旧到新重放各扇区建立索引，上电调用一次
+ * @return 成功返回true；Flash操作失败返回false
+ * @note  没有有效扇区时(第一次使用)启用第一个扇区；上次回收中途掉电时继续完成回收
+ */
+bool KV_Init(void)
+{
+    uint8_t order[KV_STORE_SECTOR_COUNT];
+    uint8_t count = 0;
+
+    memset(KV_index, 0, sizeof(KV_index));
+    KV_active = KV_STORE_NO_SECTOR;
+    for (uint8_t i = 0; i < KV_STORE_SECTOR_COUNT; i++)
+    {
+        KV_valid[i] = KV_Header_Valid(i, &KV_sequence[i]);
+        if (!KV_valid[i])
+        {
+            continue;
+        }
+        uint8_t j = count++; // 按序号插入排序，扇区数很少
+        while (j > 0 && (int32_t)(KV_sequence[order[j - 1]] - KV_sequence[i]) > 0)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    if (0 == count)
+    {
+        return KV_Open_Sector(0, 1);
+    }
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        KV_offset = KV_Replay(order[i]);
+    }
+    KV_active = order[count - 1];
+    if (KV_STORE_SECTOR_COUNT == count)
+    {
+        return KV_Collect(); // 没有空闲扇区，回收中途掉电
+    }
+    return true;
+}
+
+/**
+ * @brief 写入一个键值
+ * @param key： 键，0~KV_STORE_KEY_MAX-1
+ * @param value： 值
+ * @param len： 值的字节数，1~KV_STORE_VALUE_MAX
+ * @return 成功(或值未变化)返回true；参数错误、未挂载或Flash操作失败返回false
+ */
+bool KV_Put(uint8_t key, const void *value, uint8_t len)
+{
+    if (key >= KV_STORE_KEY_MAX || 0 == len || len > KV_STORE_VALUE_MAX || KV_STORE_NO_SECTOR == KV_active)
+    {
+        return false;
+    }
+    if (KV_index[key] != 0)
+    {
+        const volatile uint32_t *p = (const volatile uint32_t *)KV_index[key];
+        if ((uint8_t)(p[0] >> 16) == len && 0 == memcmp((const void *)(p + 1), value, len))
+        {
+            return true; // 值未变化，不写Flash
+        }
+    }
+    if (KV_Append(key, value, len))
+    {
+        return true;
+    }
+    return KV_Rotate() && KV_Append(key, value, len);
+}
+
+/**
+ * @brief 读出一个键值，按索引直接定位
+ * @param value： 输出缓冲区
+ * @param size： 缓冲区大小，值更长时截断
+ * @return 保存的值的字节数，没有保存过返回0
+ */
+uint8_t KV_Get(uint8_t key, void *value, uint8_t size)
+{
+    if (key >= KV_STORE_KEY_MAX || 0 == KV_index[key])
+    {
+        return 0;
+    }
+    const volatile uint32_t *p = (const volatile uint32_t *)KV_index[key];
+    uint8_t len = (uint8_t)(p[0] >> 16);
+    memcpy(value, (const void *)(p + 1), (len < size) ? len : size);
+    return len;
+}
+
+/**
+ * @brief 当前扇区剩余字节数
+ */
+uint16_t KV_Free_Bytes(void)
+{
+    if (KV_STORE_NO_SECTOR == KV_active)
+    {
+        return 0;
+    }
+    return FLASH_SECTION_SIZE - KV_offset;
+}
@@ -0,0 +1,49 @@
+/*********************************************************************************************************************
+ * 本模块为片内Flash上的日志结构键值存储，多个扇区轮流写入(磨损均衡)，基于片内Flash驱动(zf_driver_flash)实现
+ * 简介：保存需要经常写的数据(如累计步数、循环次数、故障次数等计数器)，每次只追加一条记录，不擦除整页
+ * 实现：
+ *    KV_STORE_SECTOR_COUNT 个扇区组成环形日志，每个扇区开头为扇区头 | KV_STORE_MAGIC | 序号 | CRC32 |，
+ *    序号每启用一个新扇区加1，上电按序号从旧到新重放，同一键后面的记录覆盖前面的；
+ *    记录按字对齐：| 0x5A KEY LEN 0 | VALUE[LEN，补0到4字节倍数] | CRC32(前面全部) |；
+ *    RAM中按键保存最新记录的地址(索引)，读取按键直接定位，常数时间；
+ *    当前扇区写满时启用空闲扇区(序号+1)，把最旧扇区中仍是最新值的记录搬到新扇区后擦除最旧扇区作为下一个空闲扇区(回收)，
+ *    各扇区按顺序轮流擦除，擦除次数均匀。
+ * 掉电安全：
+ *    记录写一半掉电：CRC错误，上电跳过，读到的是上一次的值；
+ *    回收中掉电：最旧扇区尚未擦除，上电重放时新扇区中的副本覆盖旧记录，KV_Init() 检测到没有空闲扇区时继续完成回收。
+ * 用法：
+ * *.上电调用 KV_Init() 重放日志建立索引，再用 KV_Get() 读出保存的值
+ * *.KV_Put() 写入，值与已保存的相同时不写Flash，可以放心周期调用(如每几秒保存一次计数器)
+ * 寿命估算：
+ *    每写满一个扇区(约 4080/(8+值长度) 条记录)擦除一个扇区，各扇区轮流擦除，
+ *    可写记录总数约为 擦写寿命 * KV_STORE_SECTOR_COUNT * 每扇区记录数；4个扇区、4字节计数器时每个扇区340条记录，
+ *    按擦写寿命1万次计约1360万条，每5秒保存4个计数器约可用200天，需要更长时加大保存间隔或扇区数。
+ * 注意：
+ * *.使用扇区 KV_STORE_SECTOR_FIRST 起的 KV_STORE_SECTOR_COUNT 个扇区，不要与程序和参数表(Param_Store.h)的扇区重叠
+ * *.Link.ld 中FLASH长度为 KV_STORE_SECTOR_FIRST*4K(232K)，改动扇区位置或数量时同步修改
+ * *.Flash驱动在编程、擦除期间关闭全局中断，回收时擦除一个扇区为ms级
+ * *.使用CRC外设，与帧收发一样只能在主循环中调用
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，多扇区轮流写入的日志结构键值存储，RAM索引，回收与掉电恢复
+ ********************************************************************************************************************/
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+#include "stdint.h"
+#include <stdbool.h>
+
+#define KV_STORE_SECTOR_FIRST 58   // 第一个扇区编号
+#define KV_STORE_SECTOR_COUNT 4    // 扇区数，至少2个(其中一个总是空闲)
+#define KV_STORE_KEY_MAX 32        // 键的个数，键为 0~KV_STORE_KEY_MAX-1
+#define KV_STORE_VALUE_MAX 32      // 值的最大字节数
+#define KV_STORE_MAGIC 0x5653564B  // 扇区头标识 "KVSV"
+#define KV_STORE_RECORD_MARK 0x5A  // 记录首字节，与擦除值区分
+
+bool KV_Init(void);
+bool KV_Put(uint8_t key, const void *value, uint8_t len);
+uint8_t KV_Get(uint8_t key, void *value, uint8_t size);
+uint16_t KV_Free_Bytes(void);
+
+#endif // KV_STORE_H
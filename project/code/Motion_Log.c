@@ -0,0 +1,342 @@
+/*********************************************************************************************************************
+ * W25Q32运动黑匣子日志，用法见 Motion_Log.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，W25Q32环形事件日志，RAM暂存+后台非阻塞页编程+提前擦除，批量导出
+ * 2026-10-19     Sxxx      V1.1，页编程、导出读取改为W25Q32驱动的DMA传输，导出每次只发起一次读取，不等待
+ * 2026-10-19     Sxxx      V1.2，导出按端口发送空间流量控制，整帧放得下才发送并发起下一次读取
+ ********************************************************************************************************************/
+#include "Motion_Log.h"
+#include "zf_device_w25q32.h"
+#include "string.h"
+
+#define MOTION_LOG_RECORD_SIZE sizeof(Motion_Log_Record_TpDef_struct)
+#define MOTION_LOG_SLOTS_PER_SECTOR (W25Q32_SECTION_SIZE / MOTION_LOG_RECORD_SIZE)
+#define MOTION_LOG_SLOTS_PER_PAGE (W25Q32_PAGE_SIZE / MOTION_LOG_RECORD_SIZE)
+#define MOTION_LOG_TOTAL_SLOTS ((uint32_t)MOTION_LOG_SECTOR_COUNT * MOTION_LOG_SLOTS_PER_SECTOR)
+#define MOTION_LOG_SLOT_ADDR(slot) ((uint32_t)MOTION_LOG_FIRST_SECTOR * W25Q32_SECTION_SIZE + (slot) * MOTION_LOG_RECORD_SIZE)
+#define MOTION_LOG_ERASED_SEQ 0xFFFFFFFF
+
+typedef char Motion_Log_record_must_be_16_bytes[(16 == MOTION_LOG_RECORD_SIZE) ? 1 : -1];
+typedef char Motion_Log_needs_three_sectors[(MOTION_LOG_SECTOR_COUNT >= 3) ? 1 : -1];
+
+static Motion_log_queue_t Motion_log_queue;       // RAM暂存队列
+static uint32_t (*Motion_log_time)(void) = NULL;  // 时间戳来源
+static bool Motion_log_ready = false;             // 已初始化
+static uint32_t Motion_log_write_seq = 0;         // 下一条记录的序号，对总记录数取余即写入位置
+static uint32_t Motion_log_write_slot = 0;        // 下一条记录写入的位置(记录编号)
+static uint32_t Motion_log_oldest_slot = 0;       // 最旧记录所在扇区的起始位置
+static bool Motion_log_current_erased = false;    // 写入位置所在扇区可写(已擦除或从上电找到的空位开始)
+static bool Motion_log_next_erased = false;       // 下一个扇区已提前擦除
+static uint8_t Motion_log_page[W25Q32_PAGE_SIZE] __attribute__((aligned(4))); // 页编程缓冲区，编程期间不可修改
+
+static Protocol_Port_TpDef_struct *Motion_log_dump_port = NULL; // 导出端口，NULL为不在导出
+static uint8_t Motion_log_dump_tag = 0;                         // 导出帧标签
+static uint32_t Motion_log_dump_slot = 0;                       // 下一条要导出的位置
+static uint32_t Motion_log_dump_left = 0;                       // 剩余要扫描的记录数
+static Motion_Log_Record_TpDef_struct Motion_log_dump_buffer[MOTION_LOG_DUMP_RECORDS_PER_FRAME]; // 导出读取缓冲区，DMA写入
+static uint8_t Motion_log_dump_read = 0;                        // 缓冲区中已读出待发送的记录数
+static uint32_t Motion_log_dump_read_slot = 0;                  // 缓冲区第一条记录的位置
+
+/*
+ * @brief 记录前15字节的校验和
+ */
+static uint8_t Motion_Log_Check(const Motion_Log_Record_TpDef_struct *record)
+{
+    const uint8_t *p = (const uint8_t *)record;
+    uint8_t sum = 0xA5;
+    for (uint8_t i = 0; i < MOTION_LOG_RECORD_SIZE - 1; i++)
+    {
+        sum += p[i];
+    }
+    return sum;
+}
+
+/*
+ * @brief 校验和正确且序号与所在位置一致才是有效记录，写一半、擦一半的扇区中的残留数据几乎不可能同时满足
+ */
+static bool Motion_Log_Record_Valid(const Motion_Log_Record_TpDef_struct *record, uint32_t slot)
+{
+    return record->seq != MOTION_LOG_ERASED_SEQ && record->seq % MOTION_LOG_TOTAL_SLOTS == slot && record->check == Motion_Log_Check(record);
+}
+
+static uint32_t Motion_Log_Sector_Of(uint32_t slot)
+{
+    return slot / MOTION_LOG_SLOTS_PER_SECTOR;
+}
+
+static uint32_t Motion_Log_Next_Sector(uint32_t sector)
+{
+    return (sector + 1 < MOTION_LOG_SECTOR_COUNT) ? sector + 1 : 0;
+}
+
+/**
+ * @brief 初始化：找到最新扇区中的写入位置，之后的记录接着序号写
+ * @param get_time_ms： 时间戳来源(ms)
+ * @return 成功返回true
+ * @warning 在 w25q32_init() 成功后调用；上电时芯片可能还在完成掉电前的擦除，这里会等待
+ */
+bool Motion_Log_Init(uint32_t (*get_time_ms)(void))
+{
+    Motion_Log_Record_TpDef_struct record;
+    uint32_t newest_seq = 0, oldest_seq = 0;
+    uint32_t newest = MOTION_LOG_SECTOR_COUNT, oldest = MOTION_LOG_SECTOR_COUNT;
+
+    Motion_log_time = get_time_ms;
+    Motion_log_queue_init(&Motion_log_queue);
+    while (w25q32_is_busy())
+    {
+    }
+
+    for (uint32_t sector = 0; sector < MOTION_LOG_SECTOR_COUNT; sector++) // 各扇区第一条记录的序号
+    {
+        uint32_t slot = sector * MOTION_LOG_SLOTS_PER_SECTOR;
+        w25q32_read_addr(MOTION_LOG_SLOT_ADDR(slot), (uint8 *)&record, MOTION_LOG_RECORD_SIZE);
+        if (!Motion_Log_Record_Valid(&record, slot))
+        {
+            continue; // 空扇区，或第一条记录写一半掉电(该扇区之后没有再写)
+        }
+        uint32_t seq = record.seq;
+        if (MOTION_LOG_SECTOR_COUNT == newest || seq > newest_seq)
+        {
+            newest = sector;
+            newest_seq = seq;
+        }
+        if (MOTION_LOG_SECTOR_COUNT == oldest || seq < oldest_seq)
+        {
+            oldest = sector;
+            oldest_seq = seq;
+        }
+    }
+
+    Motion_log_next_erased = false; // 上电后不确定下一个扇区是否完整擦除，重新擦一次
+    if (MOTION_LOG_SECTOR_COUNT == newest)
+    {
+        Motion_log_write_slot = 0; // 空日志
+        Motion_log_oldest_slot = 0;
+        Motion_log_write_seq = 0;
+        Motion_log_current_erased = false;
+        Motion_log_ready = true;
+        return true;
+    }
+
+    Motion_log_oldest_slot = oldest * MOTION_LOG_SLOTS_PER_SECTOR;
+    Motion_log_current_erased = false;
+    Motion_log_write_slot = Motion_Log_Next_Sector(newest) * MOTION_LOG_SLOTS_PER_SECTOR; // 最新扇区已写满时从下一个扇区开始
+    for (uint32_t i = 0; i < MOTION_LOG_SLOTS_PER_SECTOR; i++)
+    {
+        uint32_t slot = newest * MOTION_LOG_SLOTS_PER_SECTOR + i;
+        w25q32_read_addr(MOTION_LOG_SLOT_ADDR(slot), (uint8 *)&record, MOTION_LOG_RECORD_SIZE);
+        if (Motion_Log_Record_Valid(&record, slot))
+        {
+            newest_seq = record.seq;
+            continue;
+        }
+        if (MOTION_LOG_ERASED_SEQ == record.seq && 0xFF == record.check)
+        {
+            Motion_log_write_slot = slot; // 第一个空位
+            Motion_log_current_erased = true;
+            break;
+        }
+        // 写一半的记录，跳过
+    }
+    Motion_log_write_seq = newest_seq + (Motion_log_write_slot + MOTION_LOG_TOTAL_SLOTS - newest_seq % MOTION_LOG_TOTAL_SLOTS) % MOTION_LOG_TOTAL_SLOTS;
+    if (!Motion_log_current_erased && Motion_Log_Sector_Of(Motion_log_write_slot) == oldest)
+    {
+        Motion_log_oldest_slot = Motion_Log_Next_Sector(oldest) * MOTION_LOG_SLOTS_PER_SECTOR; // 即将覆盖最旧扇区
+    }
+    Motion_log_ready = true;
+    return true;
+}
+
+/**
+ * @brief 记录一个事件，只放入RAM暂存队列，不访问SPI
+ * @param type： Motion_Log_Type_enum
+ * @param arg： 参数
+ * @param value： 数值
+ */
+void Motion_Log_Event(uint8_t type, uint16_t arg, int32_t value)
+{
+    Motion_Log_Record_TpDef_struct *record = Motion_log_queue_write_slot(&Motion_log_queue);
+    if (NULL == record)
+    {
+        Motion_log_queue.overflow_count++;
+        return;
+    }
+    record->time_ms = (Motion_log_time != NULL) ? Motion_log_time() : 0;
+    record->value = value;
+    record->arg = arg;
+    record->type = type;
+    Motion_log_queue_write_commit(&Motion_log_queue); // 序号和校验和在写入Flash时填写
+}
+
+/*
+ * @brief 把暂存队列中的记录写入当前页(不跨页)，发起页编程
+ */
+static void Motion_Log_Program(void)
+{
+    uint32_t room = MOTION_LOG_SLOTS_PER_PAGE - Motion_log_write_slot % MOTION_LOG_SLOTS_PER_PAGE;
+    uint32_t count = Motion_log_queue_num_items(&Motion_log_queue);
+    if (count > room)
+    {
+        count = room;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        Motion_Log_Record_TpDef_struct *record = (Motion_Log_Record_TpDef_struct *)Motion_log_page + i;
+        memcpy(record, Motion_log_queue_read_slot(&Motion_log_queue), MOTION_LOG_RECORD_SIZE);
+        Motion_log_queue_read_advance(&Motion_log_queue);
+        record->seq = Motion_log_write_seq++;
+        record->check = Motion_Log_Check(record);
+    }
+    w25q32_write_addr_start(MOTION_LOG_SLOT_ADDR(Motion_log_write_slot), Motion_log_page, (uint16)(count * MOTION_LOG_RECORD_SIZE));
+
+    Motion_log_write_slot += count;
+    if (Motion_log_write_slot >= MOTION_LOG_TOTAL_SLOTS)
+    {
+        Motion_log_write_slot = 0;
+    }
+    if (0 == Motion_log_write_slot % MOTION_LOG_SLOTS_PER_SECTOR) // 进入下一个扇区
+    {
+        Motion_log_current_erased = Motion_log_next_erased;
+        Motion_log_next_erased = false;
+    }
+}
+
+/*
+ * @brief 擦除一个扇区，被擦除的是最旧扇区时最旧位置后移
+ */
+static void Motion_Log_Erase(uint32_t sector)
+{
+    if (sector * MOTION_LOG_SLOTS_PER_SECTOR == Motion_log_oldest_slot && sector != Motion_Log_Sector_Of(Motion_log_write_slot))
+    {
+        Motion_log_oldest_slot = Motion_Log_Next_Sector(sector) * MOTION_LOG_SLOTS_PER_SECTOR;
+    }
+    w25q32_erase_sector_start(MOTION_LOG_SLOT_ADDR(sector * MOTION_LOG_SLOTS_PER_SECTOR));
+}
+
+/*
+ * @brief 导出：先发出上次读出的一组中有效的记录，再发起下一组的DMA读取，读取完成前不等待
+ * @note  端口发送缓冲区放不下整帧时直接返回，已读出的记录留在缓冲区下次再发
+ */
+static void Motion_Log_Dump_Step(void)
+{
+    if (Motion_log_dump_read > 0)
+    {
+        if (!Protocol_Port_Can_Send(Motion_log_dump_port, Motion_log_dump_read * MOTION_LOG_RECORD_SIZE))
+        {
+            return; // 按整组长度判断，压缩前后都放得下
+        }
+        uint8_t valid = 0;
+        for (uint32_t i = 0; i < Motion_log_dump_read; i++)
+        {
+            if (Motion_Log_Record_Valid(&Motion_log_dump_buffer[i], Motion_log_dump_read_slot + i))
+            {
+                Motion_log_dump_buffer[valid++] = Motion_log_dump_buffer[i];
+            }
+        }
+        Motion_log_dump_read = 0;
+        if (valid) // 擦除区域不发帧
+        {
+            Protocol_Port_Send_Frame(Motion_log_dump_port, Motion_log_dump_tag, BINFRAME_TYPE_RAW, Motion_log_dump_buffer, valid * MOTION_LOG_RECORD_SIZE);
+        }
+    }
+    if (0 == Motion_log_dump_left)
+    {
+        if (!Protocol_Port_Can_Send(Motion_log_dump_port, 0))
+        {
+            return;
+        }
+        Protocol_Port_Send_Frame(Motion_log_dump_port, Motion_log_dump_tag, BINFRAME_TYPE_RAW, Motion_log_dump_buffer, 0); // 导出结束，空载荷(不传NULL给memcpy)
+        Motion_log_dump_port = NULL;
+        return;
+    }
+    uint32_t count = MOTION_LOG_DUMP_RECORDS_PER_FRAME;
+    uint32_t to_end = MOTION_LOG_TOTAL_SLOTS - Motion_log_dump_slot;
+    if (count > Motion_log_dump_left)
+        count = Motion_log_dump_left;
+    if (count > to_end)
+        count = to_end;
+    w25q32_read_addr_start(MOTION_LOG_SLOT_ADDR(Motion_log_dump_slot), (uint8 *)Motion_log_dump_buffer, (uint16)(count * MOTION_LOG_RECORD_SIZE));
+    Motion_log_dump_read = (uint8_t)count;
+    Motion_log_dump_read_slot = Motion_log_dump_slot;
+    Motion_log_dump_slot = (Motion_log_dump_slot + count) % MOTION_LOG_TOTAL_SLOTS;
+    Motion_log_dump_left -= count;
+}
+
+/**
+ * @brief 后台处理，每次最多发起一个Flash操作，不等待芯片忙
+ * @return 还有待做的工作(芯片忙、暂存队列非空、需要擦除或正在导出)返回true，否则返回false
+ * @warning 在主循环(任务)中调用
+ */
+bool Motion_Log_Process(void)
+{
+    if (!Motion_log_ready)
+    {
+        return false;
+    }
+    if (w25q32_is_busy())
+    {
+        return true; // 编程或擦除中
+    }
+    uint32_t sector = Motion_Log_Sector_Of(Motion_log_write_slot);
+    if (!Motion_log_current_erased)
+    {
+        Motion_Log_Erase(sector);
+        Motion_log_current_erased = true;
+        return true;
+    }
+    if (!Motion_log_queue_is_empty(&Motion_log_queue))
+    {
+        Motion_Log_Program();
+        return true;
+    }
+    if (!Motion_log_next_erased)
+    {
+        Motion_Log_Erase(Motion_Log_Next_Sector(sector)); // 队列空闲时提前擦除，换扇区时不用等擦除
+        Motion_log_next_erased = true;
+        return true;
+    }
+    if (Motion_log_dump_port != NULL)
+    {
+        Motion_Log_Dump_Step();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 开始导出，由 Motion_Log_Process() 分多次发出
+ * @param port： 导出端口
+ * @param tag： 导出帧标签
+ * @param count： 导出最近的记录数，0或超过已有记录数时导出全部
+ * @return 已在导出或未初始化返回false
+ * @note  只导出已写入Flash的记录，暂存队列中的记录写入后可再次导出
+ */
+bool Motion_Log_Dump(Protocol_Port_TpDef_struct *port, uint8_t tag, uint32_t count)
+{
+    if (!Motion_log_ready || Motion_log_dump_port != NULL || NULL == port)
+    {
+        return false;
+    }
+    uint32_t available = (Motion_log_write_slot + MOTION_LOG_TOTAL_SLOTS - Motion_log_oldest_slot) % MOTION_LOG_TOTAL_SLOTS;
+    if (0 == count || count > available)
+    {
+        count = available;
+    }
+    Motion_log_dump_slot = (Motion_log_write_slot + MOTION_LOG_TOTAL_SLOTS - count) % MOTION_LOG_TOTAL_SLOTS;
+    Motion_log_dump_left = count;
+    Motion_log_dump_read = 0;
+    Motion_log_dump_tag = tag;
+    Motion_log_dump_port = port;
+    return true;
+}
+
+/**
+ * @brief 暂存队列满而丢弃的事件数
+ */
+uint32_t Motion_Log_Dropped_Count(void)
+{
+    return Motion_log_queue.overflow_count;
+}
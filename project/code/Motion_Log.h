@@ -0,0 +1,76 @@
+/*********************************************************************************************************************
+ * 本模块为外部Flash(W25Q32)上的运动黑匣子日志，基于 zf_device_w25q32 的非阻塞编程/擦除接口实现
+ * 简介：电机启动、停止、状态切换等事件带时间戳和序号写入W25Q32环形日志，写满后覆盖最旧的扇区，
+ *       掉电后仍可导出，用于事后分析
+ * 实现：
+ *    Motion_Log_Event() 只把16字节的事件记录放入RAM暂存队列(不访问SPI)，立即返回；
+ *    Motion_Log_Process() 在后台任务中调用，每次只发起一个Flash操作后返回，不等待芯片忙：
+ *       芯片忙(DMA传输中，编程约0.7ms，擦除约45ms)时直接返回 -> 当前扇区未擦除则发起擦除
+ *       -> 暂存队列有记录则把当前页能放下的记录一次页编程(DMA发送) -> 提前擦除下一个扇区
+ *       -> 导出：发出上次读出的一组记录并发起下一组的DMA读取；
+ *    记录：| SEQ[4] | TIME_MS[4] | VALUE[4] | ARG[2] | TYPE | CHECK |(小端)，CHECK为前15字节的校验和，
+ *          SEQ为写入时的累计记录序号，SEQ % 总记录数 等于记录所在位置，SEQ为0xFFFFFFFF表示未写(擦除状态)，
+ *          校验和错误或序号与位置不符的为写一半、擦一半掉电的残留数据；
+ *    上电读各扇区第一条记录的序号找出最新、最旧扇区，再在最新扇区中找到第一个空位继续写。
+ * 导出帧(RAW载荷)：每帧最多 MOTION_LOG_DUMP_RECORDS_PER_FRAME 条记录原样排列，导出结束发一个空载荷帧
+ * 用法：
+ * *.w25q32_init() 成功后调用 Motion_Log_Init() 恢复写入位置(需要扫描约1024个扇区头，约10ms)
+ * *.事件处调用 Motion_Log_Event()，后台任务周期调用 Motion_Log_Process()，返回false时没有待做的工作可挂起任务
+ * *.Motion_Log_Dump() 从指定端口导出最近N条记录(0为全部)，由 Motion_Log_Process() 分多次发出，每次调用最多一帧；
+ *   端口发送缓冲区放不下整帧(Protocol_Port_Can_Send)时本次不发，导出速度跟随端口带宽
+ * 注意：
+ * *.Motion_Log_Event() 只能有一个生产者上下文(如都在主循环任务中调用)；Motion_Log_Process() 使用CRC外设发帧，只在主循环中调用
+ * *.占用W25Q32从 MOTION_LOG_FIRST_SECTOR 起的 MOTION_LOG_SECTOR_COUNT 个扇区，其他代码不要使用W25Q32的这些扇区
+ * *.暂存队列满时新事件丢弃并计数(Motion_Log_Dropped_Count)，掉电时暂存队列中未写入的记录丢失
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，W25Q32环形事件日志，RAM暂存+后台非阻塞页编程+提前擦除，批量导出
+ * 2026-10-19     Sxxx      V1.1，页编程、导出读取改为W25Q32驱动的DMA传输，导出每次只发起一次读取，不等待
+ * 2026-10-19     Sxxx      V1.2，导出按端口发送空间流量控制，整帧放得下才发送并发起下一次读取
+ ********************************************************************************************************************/
+#ifndef MOTION_LOG_H
+#define MOTION_LOG_H
+
+#include "stdint.h"
+#include <stdbool.h>
+#include "Ring_Buffer.h"
+#include "Protocol_Engine.h"
+
+#define MOTION_LOG_FIRST_SECTOR 0            // 第一个W25Q32扇区(4K)编号
+#define MOTION_LOG_SECTOR_COUNT 1024         // 扇区数，W25Q32整片为1024，至少3个
+#define MOTION_LOG_QUEUE_SIZE 64             // 暂存队列大小，必须是2的幂，要能放下一次扇区擦除(最长400ms)期间的事件
+#define MOTION_LOG_DUMP_RECORDS_PER_FRAME 4  // 导出帧每帧记录数，不超过 BINFRAME_PAYLOAD_MAX/16
+
+// 事件类型
+typedef enum
+{
+    MOTION_LOG_BOOT = 1,  // 上电，VALUE为累计启动次数
+    MOTION_LOG_START,     // 电机启动，ARG为PWM占空比
+    MOTION_LOG_STOP,      // 电机停止
+    MOTION_LOG_STATE,     // 运动状态切换，ARG为新状态
+    MOTION_LOG_STEP,      // 步数变化，VALUE为步数
+    MOTION_LOG_FAULT,     // 故障，ARG为故障码
+    MOTION_LOG_USER = 0x80, // 用户自定义事件从这里开始
+} Motion_Log_Type_enum;
+
+// 一条事件记录，16字节，W25Q32一页放16条
+typedef struct
+{
+    uint32_t seq;     // 序号，每写入一条加1，写入Flash时填写
+    uint32_t time_ms; // 时间戳
+    int32_t value;    // 数值
+    uint16_t arg;     // 参数(电机编号、PWM、状态等)
+    uint8_t type;     // Motion_Log_Type_enum
+    uint8_t check;    // 前15字节的校验和，写入Flash时填写
+} Motion_Log_Record_TpDef_struct;
+
+RING_DEFINE(Motion_log_queue, Motion_Log_Record_TpDef_struct, MOTION_LOG_QUEUE_SIZE)
+
+bool Motion_Log_Init(uint32_t (*get_time_ms)(void));
+void Motion_Log_Event(uint8_t type, uint16_t arg, int32_t value);
+bool Motion_Log_Process(void);
+bool Motion_Log_Dump(Protocol_Port_TpDef_struct *port, uint8_t tag, uint32_t count);
+uint32_t Motion_Log_Dropped_Count(void);
+
+#endif // MOTION_LOG_H
@@ -0,0 +1,314 @@
+/*********************************************************************************************************************
+ * 掉电保存的参数表，用法见 Param_Store.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，双扇区只追加日志+CRC+整理的参数掉电保存，标签分发器读写
+ * 2026-10-19     Sxxx      V1.1，上电扫描不在空位置停止，一直扫描到扇区末尾，编程失败被跳过的位置之后的记录也能恢复
+ ********************************************************************************************************************/
+#include "Param_Store.h"
+#include "zf_driver_flash.h"
+#include "string.h"
+
+#define PARAM_STORE_RECORD_SIZE sizeof(Param_Record_TpDef_struct)
+#define PARAM_STORE_SECTOR_ADDR(sector) ((const volatile uint32_t *)(FLASH_BASE_ADDR + FLASH_SECTION_SIZE * (sector)))
+#define PARAM_STORE_NO_SECTOR 0xFF
+
+static uint32_t Param_persist[8];                    // 登记为参数的标签位图
+static uint32_t Param_dirty[8];                      // 已改动未保存的标签位图
+static bool Param_pending = false;                   // 有未保存的改动
+static uint16_t Param_quiet_ms = 0;                  // 最后一次改动后经过的时间
+static uint8_t Param_sector = PARAM_STORE_NO_SECTOR; // 当前扇区
+static uint32_t Param_generation = 0;                // 当前扇区代数
+static uint16_t Param_offset = 0;                    // 当前扇区下一条记录的字节偏移
+
+static inline bool Param_Bit_Test(const uint32_t *map, uint8_t tag)
+{
+    return (map[tag >> 5] >> (tag & 31)) & 1u;
+}
+
+static inline void Param_Bit_Set(uint32_t *map, uint8_t tag)
+{
+    map[tag >> 5] |= 1u << (tag & 31);
+}
+
+static inline void Param_Bit_Clear(uint32_t *map, uint8_t tag)
+{
+    map[tag >> 5] &= ~(1u << (tag & 31));
+}
+
+/*
+ * @brief 计算记录前两个字的CRC32
+ */
+static uint32_t Param_Record_CRC(const volatile uint32_t *words)
+{
+    return BinFrame_CRC((const uint8_t *)words, 8);
+}
+
+/*
+ * @brief 检查扇区头
+ * @return 有效返回true，并取出代数
+ */
+static bool Param_Header_Valid(uint8_t sector, uint32_t *generation)
+{
+    const volatile uint32_t *p = PARAM_STORE_SECTOR_ADDR(sector);
+    if (p[0] != PARAM_STORE_MAGIC || p[2] != Param_Record_CRC(p))
+    {
+        return false;
+    }
+    *generation = p[1];
+    return true;
+}
+
+/*
+ * @brief 按登记项的当前值生成一条记录
+ */
+static void Param_Record_Make(Param_Record_TpDef_struct *record, const PacketFrame_TpDef_struct *entry)
+{
+    uint8_t size = BinFrame_Type_Size(entry->type);
+    record->head = PARAM_STORE_RECORD_MARK | ((uint32_t)entry->tag << 8) | ((uint32_t)entry->type << 16) | ((uint32_t)size << 24);
+    record->value = 0;
+    memcpy(&record->value, entry->value_ptr, size);
+    record->crc = Param_Record_CRC(&record->head);
+}
+
+/*
+ * @brief 整理：擦除目标扇区，写入全部参数的当前值，最后写扇区头切换为当前扇区
+ * @return 成功返回true；失败时当前扇区不变
+ */
+static bool Param_Compact(uint8_t sector, uint32_t generation)
+{
+    Param_Record_TpDef_struct record;
+    uint16_t offset = PARAM_STORE_RECORD_SIZE; // 第一条位置留给扇区头
+
+    if (flash_erase_sector(sector, 0))
+    {
+        return false;
+    }
+    for (uint16_t tag = 0; tag < 256; tag++)
+    {
+        const PacketFrame_TpDef_struct *entry = Protocol_Find((uint8_t)tag);
+        if (!Param_Bit_Test(Param_persist, (uint8_t)tag) || NULL == entry)
+        {
+            continue;
+        }
+        Param_Record_Make(&record, entry);
+        if (flash_write_words(sector, offset, (const uint32 *)&record, PARAM_STORE_RECORD_SIZE / 4))
+        {
+            return false;
+        }
+        offset += PARAM_STORE_RECORD_SIZE;
+    }
+
+    record.head = PARAM_STORE_MAGIC;
+    record.value = generation;
+    record.crc = Param_Record_CRC(&record.head);
+    if (flash_write_words(sector, 0, (const uint32 *)&record, PARAM_STORE_RECORD_SIZE / 4)) // 扇区头最后写，之前掉电不影响旧扇区
+    {
+        return false;
+    }
+
+    Param_sector = sector;
+    Param_generation = generation;
+    Param_offset = offset;
+    memset(Param_dirty, 0, sizeof(Param_dirty)); // 全部参数已写入
+    return true;
+}
+
+/*
+ * @brief 写入通知，标签分发器写入参数后记为待保存
+ */
+static void Param_Write_Hook(const PacketFrame_TpDef_struct *entry)
+{
+    if (Param_Bit_Test(Param_persist, entry->tag))
+    {
+        Param_Bit_Set(Param_dirty, entry->tag);
+        Param_pending = true;
+        Param_quiet_ms = 0;
+    }
+}
+
+/**
+ * @brief 登记参数表，同时登记到标签分发器并挂载写入通知
+ * @param Param_table[]： 参数登记项数组，数组需一直有效(全局或静态)
+ * @param count： 数量
+ * @return 全部登记成功返回true；存储变量为NULL、类型不是数值类型或标签重复的项不作为参数，返回false
+ * @warning 在 Param_Load() 前调用，可分多次登记
+ */
+bool Param_Register(const PacketFrame_TpDef_struct Param_table[], uint16_t count)
+{
+    bool ok = Protocol_Register(Param_table, count);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t size = BinFrame_Type_Size(Param_table[i].type);
+        if (NULL == Param_table[i].value_ptr || 0 == size || size > 4 || Protocol_Find(Param_table[i].tag) != &Param_table[i])
+        {
+            ok = false;
+            continue;
+        }
+        Param_Bit_Set(Param_persist, Param_table[i].tag);
+    }
+    Protocol_Set_Write_Hook(Param_Write_Hook);
+    return ok;
+}
+
+/**
+ * @brief 从Flash恢复参数，上电初始化时调用一次
+ * @return 恢复的参数个数；Flash中没有有效扇区时格式化扇区A并写入当前值，返回0
+ * @note  记录的类型、长度与登记项不一致(参数表改过)的忽略，下次整理时丢弃
+ */
+uint16_t Param_Load(void)
+{
+    uint32_t generation_a = 0, generation_b = 0;
+    bool valid_a = Param_Header_Valid(PARAM_STORE_SECTOR_A, &generation_a);
+    bool valid_b = Param_Header_Valid(PARAM_STORE_SECTOR_B, &generation_b);
+    uint32_t restored[8] = {0};
+    uint16_t count = 0;
+
+    if (!valid_a && !valid_b)
+    {
+        Param_Compact(PARAM_STORE_SECTOR_A, 1);
+        return 0;
+    }
+    if (valid_a && (!valid_b || (int32_t)(generation_a - generation_b) > 0))
+    {
+        Param_sector = PARAM_STORE_SECTOR_A;
+        Param_generation = generation_a;
+    }
+    else
+    {
+        Param_sector = PARAM_STORE_SECTOR_B;
+        Param_generation = generation_b;
+    }
+
+    const volatile uint32_t *base = PARAM_STORE_SECTOR_ADDR(Param_sector);
+    uint16_t end = PARAM_STORE_RECORD_SIZE; // 最后一条编程过的记录之后
+    for (uint16_t offset = PARAM_STORE_RECORD_SIZE; offset + PARAM_STORE_RECORD_SIZE <= FLASH_SECTION_SIZE; offset += PARAM_STORE_RECORD_SIZE)
+    {
+        const volatile uint32_t *p = base + offset / 4;
+        uint32_t head = p[0];
+        if (FLASH_ERASED_WORD == head && FLASH_ERASED_WORD == p[1] && FLASH_ERASED_WORD == p[2])
+        {
+            continue; // 空位置：日志末尾，或编程失败被跳过的位置，后面可能还有记录，扫描到扇区末尾
+        }
+        end = offset + PARAM_STORE_RECORD_SIZE;
+        if ((head & 0xFF) != PARAM_STORE_RECORD_MARK || p[2] != Param_Record_CRC(p))
+        {
+            continue; // 写一半掉电的记录
+        }
+        uint8_t tag = (uint8_t)(head >> 8);
+        uint8_t type = (uint8_t)(head >> 16);
+        uint8_t len = (uint8_t)(head >> 24);
+        const PacketFrame_TpDef_struct *entry = Protocol_Find(tag);
+        if (!Param_Bit_Test(Param_persist, tag) || NULL == entry || entry->type != type || BinFrame_Type_Size(type) != len)
+        {
+            continue;
+        }
+        uint32_t value = p[1];
+        memcpy(entry->value_ptr, &value, len);
+        if (!Param_Bit_Test(restored, tag))
+        {
+            Param_Bit_Set(restored, tag);
+            count++;
+        }
+    }
+    Param_offset = end;
+    return count;
+}
+
+/*
+ * @brief 在当前扇区末尾追加一条记录，扇区写满时整理到另一个扇区
+ * @return 成功返回true
+ */
+static bool Param_Append(const PacketFrame_TpDef_struct *entry)
+{
+    Param_Record_TpDef_struct record;
+    Param_Record_Make(&record, entry);
+    while (Param_offset + PARAM_STORE_RECORD_SIZE <= FLASH_SECTION_SIZE)
+    {
+        uint16_t offset = Param_offset;
+        Param_offset += PARAM_STORE_RECORD_SIZE; // 编程失败的位置也不再使用
+        if (0 == flash_write_words(Param_sector, offset, (const uint32 *)&record, PARAM_STORE_RECORD_SIZE / 4))
+        {
+            return true;
+        }
+    }
+    uint8_t other = (PARAM_STORE_SECTOR_A == Param_sector) ? PARAM_STORE_SECTOR_B : PARAM_STORE_SECTOR_A;
+    return Param_Compact(other, Param_generation + 1);
+}
+
+/**
+ * @brief 立即保存全部改动的参数
+ * @return 成功返回true；未调用 Param_Load() 或Flash操作失败返回false
+ */
+bool Param_Save(void)
+{
+    bool ok = true;
+    Param_pending = false;
+    if (PARAM_STORE_NO_SECTOR == Param_sector)
+    {
+        return false;
+    }
+    for (uint16_t tag = 0; tag < 256; tag++)
+    {
+        if (!Param_Bit_Test(Param_dirty, (uint8_t)tag)) // 整理后全部清除，剩下的不再单独追加
+        {
+            continue;
+        }
+        Param_Bit_Clear(Param_dirty, (uint8_t)tag);
+        const PacketFrame_TpDef_struct *entry = Protocol_Find((uint8_t)tag);
+        if (entry != NULL && !Param_Append(entry))
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief 程序中修改参数并记为待保存
+ * @param tag： 参数标签
+ * @param value： 新值，长度为参数类型长度
+ * @return 标签不是参数返回false
+ */
+bool Param_Set(uint8_t tag, const void *value)
+{
+    const PacketFrame_TpDef_struct *entry = Protocol_Find(tag);
+    if (!Param_Bit_Test(Param_persist, tag) || NULL == entry)
+    {
+        return false;
+    }
+    memcpy(entry->value_ptr, value, BinFrame_Type_Size(entry->type));
+    Param_Write_Hook(entry);
+    return true;
+}
+
+/**
+ * @brief 延迟保存，主循环周期调用
+ * @param elapsed_ms： 距上次调用经过的时间
+ * @note  最后一次改动后 PARAM_STORE_SAVE_DELAY_MS 内没有新改动才写Flash
+ */
+void Param_Process(uint16_t elapsed_ms)
+{
+    if (!Param_pending)
+    {
+        return;
+    }
+    Param_quiet_ms += elapsed_ms;
+    if (Param_quiet_ms >= PARAM_STORE_SAVE_DELAY_MS)
+    {
+        Param_Save();
+    }
+}
+
+/**
+ * @brief 当前扇区剩余可追加的记录数，为0时下次保存会整理
+ */
+uint16_t Param_Free_Records(void)
+{
+    if (PARAM_STORE_NO_SECTOR == Param_sector)
+    {
+        return 0;
+    }
+    return (FLASH_SECTION_SIZE - Param_offset) / PARAM_STORE_RECORD_SIZE;
+}
@@ -0,0 +1,59 @@
+/*********************************************************************************************************************
+ * 本模块为掉电保存的参数表，基于协议引擎标签表(Protocol_Engine.h)和片内Flash驱动(zf_driver_flash)实现
+ * 简介：参数就是带存储变量的二进制帧标签登记项(标签、类型、存储变量)，上位机经标签分发器写入(单帧、批量帧、请求帧)
+ *       或用读取帧(BINFRAME_TAG_GET)读出，改动自动保存到Flash，上电恢复
+ * 实现：
+ *    两个4K扇区轮流使用，扇区内为只追加的记录日志，每条记录12字节(3个字)：
+ *    | 0xA5 TAG TYPE LEN | VALUE(补0到4字节) | CRC32(前两个字) |
+ *    扇区第一条为扇区头 | PARAM_STORE_MAGIC | 代数 | CRC32 |，代数大的有效扇区为当前扇区；
+ *    每次保存只在当前扇区末尾编程新记录的3个字(flash_write_words)，不擦除；
+ *    当前扇区写满时整理：擦除另一个扇区，写入全部参数的当前值，最后写扇区头(代数+1)完成切换，
+ *    写扇区头前掉电则上电仍使用旧扇区，记录写一半掉电则CRC错误被跳过，不会读到错误的值。
+ *    上电从头顺序扫描整个当前扇区(CRC外设按字计算)，同一标签后面的记录覆盖前面的，整扇区扫描远小于1ms；
+ *    编程失败的位置不再使用(可能仍是擦除值)，扫描跳过空位置直到扇区末尾，下一条记录接在最后一条编程过的记录之后。
+ * 用法：
+ * *.参数表为 PacketFrame_TpDef_struct 数组，存储变量不可为NULL，类型为1~4字节的数值类型
+ * *.初始化时 Param_Register() 登记参数表(同时登记到标签分发器，不要再调用 PacketFrame_Register())，
+ *   再调用 Param_Load() 从Flash恢复，没有保存过的参数保持变量初值
+ * *.主循环周期调用 Param_Process(经过的ms)，改动停止 PARAM_STORE_SAVE_DELAY_MS 后才写Flash，连续调参只写最后的值
+ * *.程序中修改参数用 Param_Set()，直接改变量不会保存
+ * 注意：
+ * *.使用最后两个扇区(PARAM_STORE_SECTOR_A/B)，与KV_Store.h的扇区一起已从Link.ld的FLASH中扣除(232K)，程序超出时链接报错
+ * *.Flash驱动在编程、擦除期间关闭全局中断：保存一条记录约为几十us，整理时擦除扇区为ms级(每约300次保存一次)
+ * *.本模块占用协议引擎的写入通知(Protocol_Set_Write_Hook)
+ * *.Param_Load()/Param_Process() 使用CRC外设，与帧收发一样只能在主循环中调用
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，双扇区只追加日志+CRC+整理的参数掉电保存，标签分发器读写
+ * 2026-10-19     Sxxx      V1.1，上电扫描不在空位置停止，一直扫描到扇区末尾，编程失败被跳过的位置之后的记录也能恢复
+ ********************************************************************************************************************/
+#ifndef PARAM_STORE_H
+#define PARAM_STORE_H
+
+#include "stdint.h"
+#include <stdbool.h>
+#include "Protocol_Engine.h"
+
+#define PARAM_STORE_SECTOR_A 62          // 参数日志扇区A
+#define PARAM_STORE_SECTOR_B 63          // 参数日志扇区B
+#define PARAM_STORE_SAVE_DELAY_MS 500    // 最后一次改动后多久写入Flash
+#define PARAM_STORE_MAGIC 0x4D524150     // 扇区头标识 "PARM"
+#define PARAM_STORE_RECORD_MARK 0xA5     // 记录首字节，与擦除值、扇区头区分
+
+// 一条记录(也用于扇区头)，私有
+typedef struct
+{
+    uint32_t head;  // 记录：MARK TAG TYPE LEN；扇区头：PARAM_STORE_MAGIC
+    uint32_t value; // 记录：数值；扇区头：代数
+    uint32_t crc;   // 前两个字的CRC32
+} Param_Record_TpDef_struct;
+
+bool Param_Register(const PacketFrame_TpDef_struct Param_table[], uint16_t count);
+uint16_t Param_Load(void);
+bool Param_Set(uint8_t tag, const void *value);
+void Param_Process(uint16_t elapsed_ms);
+bool Param_Save(void);
+uint16_t Param_Free_Records(void);
+
+#endif // PARAM_STORE_H
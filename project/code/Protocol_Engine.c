@@ -0,0 +1,472 @@
+/*********************************************************************************************************************
+ * 多通道二进制帧协议引擎，用法见 Protocol_Engine.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，每通道一个端口对象的可重入解帧/分发引擎，共用标签表
+ * 2026-10-19     Sxxx      V1.1，新增带序号的请求帧与ACK/NACK响应，登记项可挂载命令处理函数
+ * 2026-10-19     Sxxx      V1.2，新增读取帧(按标签读出当前值)和写入通知
+ * 2026-10-19     Sxxx      V1.3，新增 Protocol_Port_Parse_Byte，可与文本格式共用同一接收缓冲区逐字节解帧
+ * 2026-10-19     Sxxx      V1.4，端口可挂载发送空间查询函数，Protocol_Port_Can_Send() 判断整帧能否放下，供批量发送做流量控制
+ * 2026-10-19     Sxxx      V1.5，数值先交给命令处理函数，接受后才写入存储变量，被拒绝(NACK)时存储变量保持不变
+ ********************************************************************************************************************/
+#include "Protocol_Engine.h"
+#include "string.h"
+
+static const PacketFrame_TpDef_struct *Protocol_index_table[256] = {NULL}; // 二进制帧标签直接索引表，所有端口共用
+static Protocol_Write_Hook Protocol_write_hook = NULL;                        // 写入通知
+
+/**
+ * @brief 建立二进制帧标签直接索引表，初始化时调用，可分多次登记
+ * @param Frame_packet[]： 结构体数组，数组需一直有效(全局或静态)
+ * @param tag_count： 查找表数量
+ * @return 全部登记成功返回true；标签重复时保留先登记的并返回false
+ * @warning 在任何端口开始分发前完成登记，分发期间只读，不需要互斥
+ */
+bool Protocol_Register(const PacketFrame_TpDef_struct Frame_packet[], uint16_t tag_count)
+{
+    bool ok = true;
+    for (uint16_t i = 0; i < tag_count; i++)
+    {
+        if (Protocol_index_table[Frame_packet[i].tag] != NULL)
+        {
+            ok = false;
+            continue;
+        }
+        Protocol_index_table[Frame_packet[i].tag] = &Frame_packet[i];
+    }
+    return ok;
+}
+
+/**
+ * @brief 按标签编号查找登记项
+ * @return 登记项，未登记返回NULL
+ */
+const PacketFrame_TpDef_struct *Protocol_Find(uint8_t tag)
+{
+    return Protocol_index_table[tag];
+}
+
+/**
+ * @brief 挂载写入通知，数值写入登记项的存储变量(value_ptr不为NULL)且处理函数接受后调用，传NULL取消
+ * @note  通知在分发的上下文(主循环)中调用，批量帧每个条目调用一次
+ */
+void Protocol_Set_Write_Hook(Protocol_Write_Hook hook)
+{
+    Protocol_write_hook = hook;
+}
+
+/**
+ * @brief 初始化端口对象
+ * @param port： 端口对象
+ * @param name： 通道名
+ * @param rx_ring： 接收环形缓冲区
+ * @param rx_place： 接收缓冲区存储区，大小必须是2的幂；传NULL表示rx_ring已由调用者初始化(如DMA直接写入的缓冲区)
+ * @param rx_size： 存储区大小
+ * @param write： 发送函数，为NULL时不回应答
+ */
+void Protocol_Port_Init(Protocol_Port_TpDef_struct *port, const char *name, ring_buffer_t *rx_ring, char *rx_place, ring_buffer_size_t rx_size, Protocol_Write_Handler write)
+{
+    port->name = name;
+    port->rx_ring = rx_ring;
+    if (rx_place != NULL)
+    {
+        ring_buffer_init(rx_ring, rx_place, rx_size);
+    }
+    BinFrame_Decoder_Reset(&port->decoder);
+    Protocol_packet_queue_init(&port->queue);
+    port->write = write;
+    port->tx_free = NULL;
+    port->dispatch_count = 0;
+    port->unknown_tag_count = 0;
+    port->type_error_count = 0;
+    port->reject_count = 0;
+    port->duplicate_count = 0;
+    memset(port->seq_history, 0, sizeof(port->seq_history));
+    port->seq_history_index = 0;
+}
+
+/**
+ * @brief 向端口送入收到的字节(SPSC生产者，可在中断或USB回调中调用)
+ * @return 放入的字节数，缓冲区满时其余字节丢弃并计入 rx_ring->overflow_count
+ */
+ring_buffer_size_t Protocol_Port_Feed(Protocol_Port_TpDef_struct *port, const uint8_t *data, uint16_t len)
+{
+    return ring_buffer_queue_arr_spsc(port->rx_ring, (const char *)data, len);
+}
+
+/**
+ * @brief 向端口解帧器送入一个字节，解出的帧直接写入包队列槽位
+ * @note  调用前需确认包队列未满；用于和其它格式共用同一接收缓冲区的场合
+ * @return 本字节完成一帧返回true
+ */
+bool Protocol_Port_Parse_Byte(Protocol_Port_TpDef_struct *port, uint8_t byte)
+{
+    if (BinFrame_Decode_Byte(&port->decoder, byte, Protocol_packet_queue_write_slot(&port->queue)))
+    {
+        Protocol_packet_queue_write_commit(&port->queue);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 解析端口接收缓冲区中的字节，解出的帧直接写入包队列槽位
+ * @note  包队列满时停止取字节，数据留在接收缓冲区，不会丢帧
+ */
+void Protocol_Port_Parse(Protocol_Port_TpDef_struct *port)
+{
+    char *span = NULL;
+    ring_buffer_size_t span_len = 0;
+    ring_buffer_size_t used = 0;
+
+    while (!Protocol_packet_queue_is_full(&port->queue) && (span_len = ring_buffer_read_span(port->rx_ring, &span)) != 0)
+    {
+        for (used = 0; used < span_len && !Protocol_packet_queue_is_full(&port->queue); used++)
+        {
+            Protocol_Port_Parse_Byte(port, (uint8_t)span[used]);
+        }
+        ring_buffer_read_advance(port->rx_ring, used); // 释放已解析的字节
+    }
+}
+
+/**
+ * @brief 从端口包队列取出最老的一帧
+ * @return 取出返回true，队列空返回false
+ */
+bool Protocol_Port_Receive(Protocol_Port_TpDef_struct *port, BinFrame_TpDef_struct *frame)
+{
+    BinFrame_TpDef_struct *next = Protocol_packet_queue_read_slot(&port->queue);
+    if (NULL == next)
+    {
+        return false;
+    }
+    *frame = *next;
+    Protocol_packet_queue_read_advance(&port->queue);
+    return true;
+}
+
+/*
+ * @brief 调用命令处理函数，接受后把数值写入登记项(类型已由调用者检查)
+ * @return PROTOCOL_DISPATCH_OK 或 PROTOCOL_DISPATCH_REJECTED(存储变量不变)
+ */
+static int8_t Protocol_Apply(const PacketFrame_TpDef_struct *entry, const uint8_t *value, uint8_t len)
+{
+    uint32_t scratch[BINFRAME_PAYLOAD_MAX / 4]; // 临时区，保证处理函数拿到4字节对齐的数值
+
+    memcpy(scratch, value, len);
+    if (entry->handler != NULL && !entry->handler(scratch))
+    {
+        return PROTOCOL_DISPATCH_REJECTED;
+    }
+    if (entry->value_ptr != NULL)
+    {
+        memcpy(entry->value_ptr, scratch, len);
+        if (Protocol_write_hook != NULL)
+        {
+            Protocol_write_hook(entry);
+        }
+    }
+    return PROTOCOL_DISPATCH_OK;
+}
+
+/**
+ * @brief 分发一个批量帧：先整批校验，全部合法后一起写入，从该端口回一个应答帧
+ * @param port： 收到该帧的端口
+ * @param frame： 批量帧(type为BINFRAME_TYPE_BATCH)
+ * @return PROTOCOL_DISPATCH_OK 全部写入；PROTOCOL_DISPATCH_BATCH_ERROR 任一条目格式错误、标签未登记或类型不一致，一条也不写入，
+ *         或有条目被命令处理函数拒绝(其余条目照常写入)
+ * @note  应答帧标签BINFRAME_TAG_ACK，RAW载荷3字节：写入条数、条目总数、首个出错条目序号(0xFF表示无错)
+ */
+int8_t Protocol_Dispatch_Batch(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame)
+{
+    BinFrame_Item_TpDef_struct item;
+    uint8_t offset = 0;
+    uint8_t total = 0;
+    uint8_t error_index = 0xFF;
+    int8_t result = 0;
+
+    // 第一遍：校验
+    while ((result = BinFrame_Batch_Next(frame, &offset, &item)) > 0)
+    {
+        const PacketFrame_TpDef_struct *entry = Protocol_index_table[item.tag];
+        if (NULL == entry || entry->type != item.type)
+        {
+            error_index = total;
+            break;
+        }
+        total++;
+    }
+    if (result < 0 && 0xFF == error_index)
+    {
+        error_index = total; // 条目格式错误
+    }
+
+    // 第二遍：全部合法才写入
+    uint8_t applied = 0;
+    bool valid = (0xFF == error_index);
+    if (valid)
+    {
+        uint8_t index = 0;
+        offset = 0;
+        while (BinFrame_Batch_Next(frame, &offset, &item) > 0)
+        {
+            if (PROTOCOL_DISPATCH_OK == Protocol_Apply(Protocol_index_table[item.tag], item.value, item.len))
+            {
+                applied++;
+            }
+            else if (0xFF == error_index)
+            {
+                error_index = index; // 首个被拒绝的条目
+                port->reject_count++;
+            }
+            index++;
+        }
+    }
+
+    uint8_t ack[3] = {applied, total, error_index};
+    Protocol_Port_Send_Frame(port, BINFRAME_TAG_ACK, BINFRAME_TYPE_RAW, ack, sizeof(ack));
+    if (!valid)
+    {
+        port->type_error_count++;
+        return PROTOCOL_DISPATCH_BATCH_ERROR;
+    }
+    if (0xFF != error_index)
+    {
+        return PROTOCOL_DISPATCH_BATCH_ERROR; // 有条目被拒绝，已计入reject_count
+    }
+    port->dispatch_count++;
+    return PROTOCOL_DISPATCH_OK;
+}
+
+/**
+ * @brief 按标签编号直接索引分发一个二进制帧，常数时间
+ * @param port： 收到该帧的端口(统计计数、批量帧应答用)
+ * @param frame： 接收的帧
+ * @return PROTOCOL_DISPATCH_OK 写入成功，其余见 PROTOCOL_DISPATCH_* 定义
+ */
+int8_t Protocol_Dispatch(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame)
+{
+    if (BINFRAME_TYPE_BATCH == frame->type)
+    {
+        return Protocol_Dispatch_Batch(port, frame);
+    }
+    if (BINFRAME_TYPE_REQUEST == frame->type)
+    {
+        return Protocol_Dispatch_Request(port, frame);
+    }
+    if (BINFRAME_TAG_GET == frame->tag && BINFRAME_TYPE_RAW == frame->type)
+    {
+        return Protocol_Dispatch_Get(port, frame);
+    }
+    const PacketFrame_TpDef_struct *entry = Protocol_index_table[frame->tag];
+    if (NULL == entry)
+    {
+        port->unknown_tag_count++;
+        return PROTOCOL_DISPATCH_UNKNOWN_TAG;
+    }
+    if (entry->type != frame->type)
+    {
+        port->type_error_count++;
+        return PROTOCOL_DISPATCH_TYPE_ERROR;
+    }
+    if (PROTOCOL_DISPATCH_OK != Protocol_Apply(entry, frame->payload, frame->len))
+    {
+        port->reject_count++;
+        return PROTOCOL_DISPATCH_REJECTED;
+    }
+    port->dispatch_count++;
+    return PROTOCOL_DISPATCH_OK;
+}
+
+/**
+ * @brief 分发一个读取帧：按载荷中的标签列表读出存储变量的当前值，以批量帧从该端口发回
+ * @note  未登记、无存储变量或数值类型的标签跳过；回复放不下时截断，上位机按回复中的标签分多次读取
+ * @return PROTOCOL_DISPATCH_OK
+ */
+int8_t Protocol_Dispatch_Get(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame)
+{
+    uint8_t reply[BINFRAME_PAYLOAD_MAX];
+    uint8_t len = 0;
+    for (uint8_t i = 0; i < frame->len; i++)
+    {
+        const PacketFrame_TpDef_struct *entry = Protocol_index_table[frame->payload[i]];
+        if (NULL == entry || NULL == entry->value_ptr)
+        {
+            continue;
+        }
+        len = BinFrame_Batch_Add(reply, len, entry->tag, entry->type, entry->value_ptr); // 非数值类型不加入
+    }
+    Protocol_Port_Send_Frame(port, BINFRAME_TAG_GET, BINFRAME_TYPE_BATCH, reply, len);
+    port->dispatch_count++;
+    return PROTOCOL_DISPATCH_OK;
+}
+
+/*
+ * @brief 在最近的请求记录中查找重发的请求
+ * @return 找到返回记录，否则返回NULL
+ */
+static const Protocol_Seq_Record_TpDef_struct *Protocol_Seq_Find(const Protocol_Port_TpDef_struct *port, uint8_t seq, uint8_t tag)
+{
+    for (uint8_t i = 0; i < PROTOCOL_SEQ_HISTORY; i++)
+    {
+        const Protocol_Seq_Record_TpDef_struct *record = &port->seq_history[i];
+        if (record->valid && record->seq == seq && record->tag == tag)
+        {
+            return record;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 分发一个请求帧，从该端口回响应帧
+ * @param port： 收到该帧的端口
+ * @param frame： 请求帧(type为BINFRAME_TYPE_REQUEST)，载荷 SEQ VTYPE VALUE
+ * @return PROTOCOL_DISPATCH_OK 已执行(或为重发的已执行请求)，其余见 PROTOCOL_DISPATCH_* 定义
+ * @note  响应帧标签与请求相同，TYPE为BINFRAME_TYPE_RESPONSE，载荷2字节：SEQ、STATUS(BinFrame_Status_enum)；
+ *        序号和标签与最近 PROTOCOL_SEQ_HISTORY 个请求之一相同时视为重发，不再执行，回原来的状态
+ */
+int8_t Protocol_Dispatch_Request(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame)
+{
+    static const int8_t status_result[] = {
+        [BINFRAME_STATUS_ACK] = PROTOCOL_DISPATCH_OK,
+        [BINFRAME_STATUS_NACK_UNKNOWN] = PROTOCOL_DISPATCH_UNKNOWN_TAG,
+        [BINFRAME_STATUS_NACK_TYPE] = PROTOCOL_DISPATCH_TYPE_ERROR,
+        [BINFRAME_STATUS_NACK_REJECTED] = PROTOCOL_DISPATCH_REJECTED,
+        [BINFRAME_STATUS_NACK_FORMAT] = PROTOCOL_DISPATCH_FORMAT_ERROR,
+    };
+    uint8_t response[2] = {frame->len ? frame->payload[0] : 0, BINFRAME_STATUS_NACK_FORMAT};
+
+    if (frame->len < BINFRAME_REQUEST_HEADER_SIZE)
+    {
+        port->type_error_count++;
+        Protocol_Port_Send_Frame(port, frame->tag, BINFRAME_TYPE_RESPONSE, response, sizeof(response));
+        return PROTOCOL_DISPATCH_FORMAT_ERROR;
+    }
+
+    const Protocol_Seq_Record_TpDef_struct *record = Protocol_Seq_Find(port, response[0], frame->tag);
+    if (record != NULL)
+    {
+        port->duplicate_count++; // 上位机没收到响应而重发，不再执行
+        response[1] = record->status;
+        Protocol_Port_Send_Frame(port, frame->tag, BINFRAME_TYPE_RESPONSE, response, sizeof(response));
+        return status_result[record->status];
+    }
+
+    uint8_t type = frame->payload[1];
+    uint8_t size = BinFrame_Type_Size(type);
+    const PacketFrame_TpDef_struct *entry = Protocol_index_table[frame->tag];
+    if (0 == size || frame->len != BINFRAME_REQUEST_HEADER_SIZE + size)
+    {
+        response[1] = BINFRAME_STATUS_NACK_FORMAT;
+        port->type_error_count++;
+    }
+    else if (NULL == entry)
+    {
+        response[1] = BINFRAME_STATUS_NACK_UNKNOWN;
+        port->unknown_tag_count++;
+    }
+    else if (entry->type != type)
+    {
+        response[1] = BINFRAME_STATUS_NACK_TYPE;
+        port->type_error_count++;
+    }
+    else if (PROTOCOL_DISPATCH_OK != Protocol_Apply(entry, frame->payload + BINFRAME_REQUEST_HEADER_SIZE, size))
+    {
+        response[1] = BINFRAME_STATUS_NACK_REJECTED;
+        port->reject_count++;
+    }
+    else
+    {
+        response[1] = BINFRAME_STATUS_ACK;
+        port->dispatch_count++;
+    }
+
+    Protocol_Seq_Record_TpDef_struct *slot = &port->seq_history[port->seq_history_index];
+    slot->seq = response[0];
+    slot->tag = frame->tag;
+    slot->status = response[1];
+    slot->valid = true;
+    port->seq_history_index = (port->seq_history_index + 1) % PROTOCOL_SEQ_HISTORY;
+
+    Protocol_Port_Send_Frame(port, frame->tag, BINFRAME_TYPE_RESPONSE, response, sizeof(response));
+    return status_result[response[1]];
+}
+
+/**
+ * @brief 端口主循环处理：解析接收缓冲区，分发包队列中的全部帧
+ * @return 本次分发的帧数
+ * @warning 只可在主循环(任务)中调用
+ */
+uint8_t Protocol_Port_Process(Protocol_Port_TpDef_struct *port)
+{
+    uint8_t count = 0;
+    BinFrame_TpDef_struct *next = NULL;
+
+    do
+    {
+        Protocol_Port_Parse(port);
+        while ((next = Protocol_packet_queue_read_slot(&port->queue)) != NULL)
+        {
+            Protocol_Dispatch(port, next); // 直接在队列槽位上分发，不拷贝
+            Protocol_packet_queue_read_advance(&port->queue);
+            count++;
+        }
+    } while (!ring_buffer_is_empty(port->rx_ring) && count < 0xFF - PROTOCOL_PORT_QUEUE_SIZE); // 队列满时留下的字节继续解析
+    return count;
+}
+
+/**
+ * @brief 端口是否还有未处理的数据(接收缓冲区中的字节或包队列中的帧)
+ * @note  为false时任务可以挂起等待接收中断
+ */
+bool Protocol_Port_Pending(const Protocol_Port_TpDef_struct *port)
+{
+    return !ring_buffer_is_empty(port->rx_ring) || !Protocol_packet_queue_is_empty(&port->queue);
+}
+
+/**
+ * @brief 从指定端口发送一个二进制帧
+ * @param port 端口，发送函数为NULL时不发送
+ * @param tag 标签
+ * @param type 载荷类型 BinFrame_Type_enum
+ * @param payload 载荷
+ * @param len 载荷长度，数值类型必须等于类型长度
+ */
+void Protocol_Port_Send_Frame(Protocol_Port_TpDef_struct *port, uint8_t tag, uint8_t type, const void *payload, uint8_t len)
+{
+    uint8_t frame[BINFRAME_FRAME_MAX] __attribute__((aligned(4)));
+    if (NULL == port->write)
+    {
+        return;
+    }
+    uint16_t frame_len = BinFrame_Encode(frame, tag, type, payload, len);
+    if (frame_len)
+    {
+        port->write(frame, frame_len);
+    }
+}
+
+/**
+ * @brief 挂载发送空间查询函数
+ * @param tx_free 返回发送缓冲区还能放下的字节数；发送函数阻塞到发完时传NULL
+ */
+void Protocol_Port_Set_Tx_Free(Protocol_Port_TpDef_struct *port, Protocol_Tx_Free_Handler tx_free)
+{
+    port->tx_free = tx_free;
+}
+
+/**
+ * @brief 发送缓冲区能否放下载荷长度为len的整帧
+ * @return 放得下(或发送函数阻塞)返回true；发送函数为NULL时返回false
+ * @note  批量、连续发送(如日志导出、遥测)在发送前调用，放不下时下次再发，避免帧被截断
+ */
+bool Protocol_Port_Can_Send(const Protocol_Port_TpDef_struct *port, uint8_t len)
+{
+    if (NULL == port->write)
+    {
+        return false;
+    }
+    return NULL == port->tx_free || port->tx_free() >= (uint16_t)(BINFRAME_HEADER_SIZE + len + BINFRAME_CRC_SIZE);
+}
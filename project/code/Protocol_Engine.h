@@ -0,0 +1,132 @@
+/*********************************************************************************************************************
+ * 本模块为多通道二进制帧协议引擎，基于Binary_Frame(帧格式)和Ring_Buffer(接收缓存、包队列)实现，与具体传输无关
+ * 简介：每个传输通道(调试串口、其他串口、USB CDC、无线串口)一个 Protocol_Port_TpDef_struct 端口对象，
+ *       解码器、包队列、统计和发送函数全部在端口对象中，各通道互不影响；标签查找表所有端口共用
+ * 实现：
+ *    接收方(中断、DMA或USB回调)把字节写入端口的接收环形缓冲区(SPSC生产者)，
+ *    主循环调用 Protocol_Port_Process() 解帧入包队列，再按标签编号直接索引分发，
+ *    批量帧的应答、出错信息从收到该帧的端口发回。
+ *    请求帧(BINFRAME_TYPE_REQUEST)带序号，执行后从该端口回响应帧(ACK/NACK)；端口记录最近 PROTOCOL_SEQ_HISTORY 个请求的结果，
+ *    上位机重发的请求(序号和标签相同)不再执行，直接回原来的结果。
+ *    读取帧(BINFRAME_TAG_GET)按标签列表读出登记项存储变量的当前值，以批量帧从该端口发回。
+ * 用法：
+ * *.初始化时 Protocol_Register() 登记标签表(PacketFrame_TpDef_struct数组)，所有端口共用，只需登记一次
+ * *.每个通道定义一个端口对象和一个接收环形缓冲区(大小为2的幂)，Protocol_Port_Init() 绑定接收缓冲区和发送函数
+ * *.接收中断或回调中调用 Protocol_Port_Feed() 送入收到的字节(DMA直接写接收缓冲区的通道可跳过)
+ * *.主循环调用 Protocol_Port_Process() 解帧并分发；需要自己处理帧时改用 Protocol_Port_Parse() + Protocol_Port_Receive()
+ * *.Protocol_Port_Send_Frame() 从指定端口发送一帧；发送缓冲区放不下的字节被丢弃，连续批量发送前用 Protocol_Port_Can_Send() 确认整帧放得下
+ *   (发送函数为非阻塞时用 Protocol_Port_Set_Tx_Free() 挂载发送空间查询函数)
+ * *.需要执行动作并返回成败的标签(如启动电机)在登记项中挂载命令处理函数，返回false时请求帧回 BINFRAME_STATUS_NACK_REJECTED；
+ *   value_ptr 可为NULL，此时数值只传给处理函数
+ * *.Protocol_Set_Write_Hook() 挂载写入通知，每次数值写入存储变量后调用(如参数持久化模块记录改动)
+ * *.上位机滑动窗口大小(未收到响应的请求数)不要超过 PROTOCOL_PORT_QUEUE_SIZE-1 和 PROTOCOL_SEQ_HISTORY
+ * 注意：
+ * *.端口对象之间可重入：解析、分发只访问自己的端口对象，共用的标签表登记后只读
+ * *.CRC外设是全局资源(见Binary_Frame.h)，各端口的 Protocol_Port_Process()/Protocol_Port_Send_Frame() 都要在主循环(同一优先级)中调用
+ * *.同一端口只能有一个生产者(Feed)和一个消费者(Process)
+ * 例子：
+ *    static ring_buffer_t wireless_rx_ring;
+ *    static char wireless_rx_place[256];
+ *    static Protocol_Port_TpDef_struct wireless_port;
+ *    Protocol_Port_Init(&wireless_port, "WIRELESS", &wireless_rx_ring, wireless_rx_place, 256, Wireless_Port_Write);
+ *    // 中断中：Protocol_Port_Feed(&wireless_port, data, len);
+ *    // 主循环中：Protocol_Port_Process(&wireless_port);
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，每通道一个端口对象的可重入解帧/分发引擎，共用标签表
+ * 2026-10-19     Sxxx      V1.1，新增带序号的请求帧与ACK/NACK响应，登记项可挂载命令处理函数
+ * 2026-10-19     Sxxx      V1.2，新增读取帧(按标签读出当前值)和写入通知
+ * 2026-10-19     Sxxx      V1.3，新增 Protocol_Port_Parse_Byte，可与文本格式共用同一接收缓冲区逐字节解帧
+ * 2026-10-19     Sxxx      V1.4，端口可挂载发送空间查询函数，Protocol_Port_Can_Send() 判断整帧能否放下，供批量发送做流量控制
+ * 2026-10-19     Sxxx      V1.5，数值先交给命令处理函数，接受后才写入存储变量，被拒绝(NACK)时存储变量保持不变
+ ********************************************************************************************************************/
+#ifndef PROTOCOL_ENGINE_H
+#define PROTOCOL_ENGINE_H
+
+#include "stdint.h"
+#include <stdbool.h>
+#include "Ring_Buffer.h"
+#include "Binary_Frame.h"
+
+#define PROTOCOL_PORT_QUEUE_SIZE 8 // 每个端口的包队列大小，必须是2的幂，可缓存 大小-1 个未处理的帧
+#define PROTOCOL_SEQ_HISTORY 8     // 每个端口记录的最近请求数，用于识别重发的请求
+
+// 分发结果
+#define PROTOCOL_DISPATCH_OK 0            // 写入成功
+#define PROTOCOL_DISPATCH_UNKNOWN_TAG -1  // 标签未登记
+#define PROTOCOL_DISPATCH_TYPE_ERROR -2   // 载荷类型与登记的不一致
+#define PROTOCOL_DISPATCH_BATCH_ERROR -3  // 批量帧中有条目错误，整批未写入
+#define PROTOCOL_DISPATCH_REJECTED -4     // 命令处理函数拒绝
+#define PROTOCOL_DISPATCH_FORMAT_ERROR -5 // 请求帧载荷格式错误
+
+// 命令处理函数，value 指向收到的数值(4字节对齐)，返回false表示拒绝执行；返回true后数值才写入存储变量
+typedef bool (*Protocol_Command_Handler)(const void *value);
+
+// 二进制帧标签表，封装标签、载荷类型以及存储变量
+typedef struct
+{
+    uint8_t tag;
+    uint8_t type;                     // BinFrame_Type_enum，与帧中类型一致才写入
+    void *value_ptr;                  // 存储变量，可为NULL(只调用处理函数)
+    Protocol_Command_Handler handler; // 命令处理函数，可省略(NULL)
+} PacketFrame_TpDef_struct;
+
+// 最近一次请求的结果，私有
+typedef struct
+{
+    uint8_t seq;
+    uint8_t tag;
+    uint8_t status; // BinFrame_Status_enum
+    bool valid;
+} Protocol_Seq_Record_TpDef_struct;
+
+// 写入通知，数值写入登记项的存储变量后调用
+typedef void (*Protocol_Write_Hook)(const PacketFrame_TpDef_struct *entry);
+
+// 端口发送函数，把一段数据交给具体传输发送
+typedef void (*Protocol_Write_Handler)(const uint8_t *data, uint16_t len);
+
+// 端口发送空间查询函数，返回发送缓冲区还能放下的字节数
+typedef uint16_t (*Protocol_Tx_Free_Handler)(void);
+
+// 端口包队列，私有
+RING_DEFINE(Protocol_packet_queue, BinFrame_TpDef_struct, PROTOCOL_PORT_QUEUE_SIZE)
+
+// 端口对象，每个传输通道一个
+typedef struct
+{
+    const char *name;                      // 通道名，调试用
+    ring_buffer_t *rx_ring;                // 接收环形缓冲区(SPSC)，私有
+    BinFrame_Decoder_TpDef_struct decoder; // 解码器，私有
+    Protocol_packet_queue_t queue;         // 已解出未处理的帧，私有
+    Protocol_Write_Handler write;          // 发送函数
+    Protocol_Tx_Free_Handler tx_free;      // 发送空间查询函数，NULL表示发送函数阻塞到发完(总能放下)
+    uint32_t dispatch_count;               // 成功分发的帧数
+    uint32_t unknown_tag_count;            // 标签未登记的帧数
+    uint32_t type_error_count;             // 类型不一致或批量帧出错的帧数
+    uint32_t reject_count;                 // 命令处理函数拒绝的帧数
+    uint32_t duplicate_count;              // 重发的请求帧数(未重复执行)
+    Protocol_Seq_Record_TpDef_struct seq_history[PROTOCOL_SEQ_HISTORY]; // 最近请求的结果，私有
+    uint8_t seq_history_index;             // 下一个记录位置，私有
+} Protocol_Port_TpDef_struct;
+
+bool Protocol_Register(const PacketFrame_TpDef_struct Frame_packet[], uint16_t tag_count);
+const PacketFrame_TpDef_struct *Protocol_Find(uint8_t tag);
+void Protocol_Set_Write_Hook(Protocol_Write_Hook hook);
+void Protocol_Port_Init(Protocol_Port_TpDef_struct *port, const char *name, ring_buffer_t *rx_ring, char *rx_place, ring_buffer_size_t rx_size, Protocol_Write_Handler write);
+ring_buffer_size_t Protocol_Port_Feed(Protocol_Port_TpDef_struct *port, const uint8_t *data, uint16_t len);
+void Protocol_Port_Parse(Protocol_Port_TpDef_struct *port);
+bool Protocol_Port_Parse_Byte(Protocol_Port_TpDef_struct *port, uint8_t byte);
+bool Protocol_Port_Receive(Protocol_Port_TpDef_struct *port, BinFrame_TpDef_struct *frame);
+int8_t Protocol_Dispatch(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame);
+int8_t Protocol_Dispatch_Batch(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame);
+int8_t Protocol_Dispatch_Get(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame);
+int8_t Protocol_Dispatch_Request(Protocol_Port_TpDef_struct *port, const BinFrame_TpDef_struct *frame);
+uint8_t Protocol_Port_Process(Protocol_Port_TpDef_struct *port);
+bool Protocol_Port_Pending(const Protocol_Port_TpDef_struct *port);
+void Protocol_Port_Send_Frame(Protocol_Port_TpDef_struct *port, uint8_t tag, uint8_t type, const void *payload, uint8_t len);
+void Protocol_Port_Set_Tx_Free(Protocol_Port_TpDef_struct *port, Protocol_Tx_Free_Handler tx_free);
+bool Protocol_Port_Can_Send(const Protocol_Port_TpDef_struct *port, uint8_t len);
+
+#endif // PROTOCOL_ENGINE_H
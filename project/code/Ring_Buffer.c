@@ -1,4 +1,5 @@
 #include "ring_buffer.h"
+#include <string.h>
 
 
 /**
@@ -12,6 +13,7 @@ void ring_buffer_init(ring_buffer_t *buffer, char *buf, size_t buf_size)
     buffer->buffer_mask = buf_size - 1;
     buffer->tail_index = 0;
     buffer->head_index = 0;
+    buffer->overflow_count = 0;
 }
 
 void ring_buffer_queue(ring_buffer_t *buffer, char data)
@@ -31,12 +33,32 @@ void ring_buffer_queue(ring_buffer_t *buffer, char data)
 
 void ring_buffer_queue_arr(ring_buffer_t *buffer, const char *data, ring_buffer_size_t size)
 {
-    /* Add bytes; one by one */
-    ring_buffer_size_t i;
-    for (i = 0; i < size; i++)
+    ring_buffer_size_t capacity = RING_BUFFER_MASK(buffer);
+    ring_buffer_size_t free_space = capacity - ring_buffer_num_items(buffer);
+    ring_buffer_size_t head = buffer->head_index;
+
+    /* Only the newest bytes survive if the array is larger than the buffer */
+    if (size > capacity)
+    {
+        data += size - capacity;
+        size = capacity;
+    }
+
+    /* Copy up to the end of the storage, then wrap around to the start */
+    ring_buffer_size_t first = capacity + 1 - head;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(&buffer->buffer[head], data, first);
+    memcpy(buffer->buffer, data + first, size - first);
+
+    /* Is going to overwrite the oldest bytes? */
+    if (size > free_space)
     {
-        ring_buffer_queue(buffer, data[i]);
+        buffer->tail_index = ((buffer->tail_index + (size - free_space)) & RING_BUFFER_MASK(buffer));
     }
+    buffer->head_index = ((head + size) & RING_BUFFER_MASK(buffer));
 }
 
 uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data)
@@ -54,22 +76,175 @@ uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data)
 
 ring_buffer_size_t ring_buffer_dequeue_arr(ring_buffer_t *buffer, char *data, ring_buffer_size_t len)
 {
-    if (ring_buffer_is_empty(buffer))
+    ring_buffer_size_t cnt = ring_buffer_num_items(buffer);
+    ring_buffer_size_t tail = buffer->tail_index;
+
+    if (cnt == 0)
     {
         /* No items */
         return 0;
     }
+    if (cnt > len)
+    {
+        cnt = len;
+    }
 
-    char *data_ptr = data;
-    ring_buffer_size_t cnt = 0;
-    while ((cnt < len) && ring_buffer_dequeue(buffer, data_ptr))
+    /* Copy up to the end of the storage, then wrap around to the start */
+    ring_buffer_size_t first = RING_BUFFER_MASK(buffer) + 1 - tail;
+    if (first > cnt)
     {
-        cnt++;
-        data_ptr++;
+        first = cnt;
     }
+    memcpy(data, &buffer->buffer[tail], first);
+    memcpy(data + first, buffer->buffer, cnt - first);
+
+    buffer->tail_index = ((tail + cnt) & RING_BUFFER_MASK(buffer));
     return cnt;
 }
 
+/*
+ * Single-producer/single-consumer mode.
+ * The producer only writes head_index and overflow_count, the consumer only
+ * writes tail_index. Data is written before head is published (release) and
+ * head is read before data is read (acquire); tail works the other way round.
+ */
+uint8_t ring_buffer_queue_spsc(ring_buffer_t *buffer, char data)
+{
+    ring_buffer_size_t head = buffer->head_index;
+    ring_buffer_size_t next = ((head + 1) & RING_BUFFER_MASK(buffer));
+
+    /* Is buffer full? Drop the newest byte, never touch tail */
+    if (next == buffer->tail_index)
+    {
+        buffer->overflow_count++;
+        return 0;
+    }
+    RING_BUFFER_FENCE_ACQUIRE(); /* Slot is free only after the consumer has read it */
+
+    buffer->buffer[head] = data;
+    RING_BUFFER_FENCE_RELEASE(); /* Data must be visible before the new head */
+    buffer->head_index = next;
+    return 1;
+}
+
+ring_buffer_size_t ring_buffer_queue_arr_spsc(ring_buffer_t *buffer, const char *data, ring_buffer_size_t size)
+{
+    ring_buffer_size_t head = buffer->head_index;
+    ring_buffer_size_t free_space = ((buffer->tail_index - head - 1) & RING_BUFFER_MASK(buffer));
+    RING_BUFFER_FENCE_ACQUIRE();
+
+    if (size > free_space)
+    {
+        buffer->overflow_count += size - free_space;
+        size = free_space;
+    }
+
+    /* Copy up to the end of the storage, then wrap around to the start */
+    ring_buffer_size_t first = RING_BUFFER_MASK(buffer) + 1 - head;
+    if (first > size)
+    {
+        first = size;
+    }
+    memcpy(&buffer->buffer[head], data, first);
+    memcpy(buffer->buffer, data + first, size - first);
+
+    RING_BUFFER_FENCE_RELEASE();
+    buffer->head_index = ((head + size) & RING_BUFFER_MASK(buffer));
+    return size;
+}
+
+uint8_t ring_buffer_dequeue_spsc(ring_buffer_t *buffer, char *data)
+{
+    ring_buffer_size_t tail = buffer->tail_index;
+
+    if (buffer->head_index == tail)
+    {
+        /* No items */
+        return 0;
+    }
+    RING_BUFFER_FENCE_ACQUIRE(); /* Read head before the data it publishes */
+
+    *data = buffer->buffer[tail];
+    RING_BUFFER_FENCE_RELEASE(); /* Finish reading before handing the slot back */
+    buffer->tail_index = ((tail + 1) & RING_BUFFER_MASK(buffer));
+    return 1;
+}
+
+ring_buffer_size_t ring_buffer_dequeue_arr_spsc(ring_buffer_t *buffer, char *data, ring_buffer_size_t len)
+{
+    ring_buffer_size_t tail = buffer->tail_index;
+    ring_buffer_size_t cnt = ((buffer->head_index - tail) & RING_BUFFER_MASK(buffer));
+    RING_BUFFER_FENCE_ACQUIRE();
+
+    if (cnt > len)
+    {
+        cnt = len;
+    }
+
+    /* Copy up to the end of the storage, then wrap around to the start */
+    ring_buffer_size_t first = RING_BUFFER_MASK(buffer) + 1 - tail;
+    if (first > cnt)
+    {
+        first = cnt;
+    }
+    memcpy(data, &buffer->buffer[tail], first);
+    memcpy(data + first, buffer->buffer, cnt - first);
+
+    RING_BUFFER_FENCE_RELEASE();
+    buffer->tail_index = ((tail + cnt) & RING_BUFFER_MASK(buffer));
+    return cnt;
+}
+
+/*
+ * Zero-copy span access. Same index ownership as SPSC mode:
+ * the reader only writes tail_index, the writer only writes head_index.
+ */
+ring_buffer_size_t ring_buffer_read_span(ring_buffer_t *buffer, char **data)
+{
+    ring_buffer_size_t tail = buffer->tail_index;
+    ring_buffer_size_t cnt = ((buffer->head_index - tail) & RING_BUFFER_MASK(buffer));
+    RING_BUFFER_FENCE_ACQUIRE();
+
+    /* Stop at the end of the storage */
+    ring_buffer_size_t contiguous = RING_BUFFER_MASK(buffer) + 1 - tail;
+    if (cnt > contiguous)
+    {
+        cnt = contiguous;
+    }
+    *data = &buffer->buffer[tail];
+    return cnt;
+}
+
+void ring_buffer_read_advance(ring_buffer_t *buffer, ring_buffer_size_t len)
+{
+    RING_BUFFER_ASSERT(len <= ring_buffer_num_items(buffer));
+    RING_BUFFER_FENCE_RELEASE();
+    buffer->tail_index = ((buffer->tail_index + len) & RING_BUFFER_MASK(buffer));
+}
+
+ring_buffer_size_t ring_buffer_write_span(ring_buffer_t *buffer, char **data)
+{
+    ring_buffer_size_t head = buffer->head_index;
+    ring_buffer_size_t free_space = ((buffer->tail_index - head - 1) & RING_BUFFER_MASK(buffer));
+    RING_BUFFER_FENCE_ACQUIRE();
+
+    /* Stop at the end of the storage */
+    ring_buffer_size_t contiguous = RING_BUFFER_MASK(buffer) + 1 - head;
+    if (free_space > contiguous)
+    {
+        free_space = contiguous;
+    }
+    *data = &buffer->buffer[head];
+    return free_space;
+}
+
+void ring_buffer_write_commit(ring_buffer_t *buffer, ring_buffer_size_t len)
+{
+    RING_BUFFER_ASSERT(len <= RING_BUFFER_MASK(buffer) - ring_buffer_num_items(buffer));
+    RING_BUFFER_FENCE_RELEASE();
+    buffer->head_index = ((buffer->head_index + len) & RING_BUFFER_MASK(buffer));
+}
+
 uint8_t ring_buffer_peek(ring_buffer_t *buffer, char *data, ring_buffer_size_t index)
 {
     if (index >= ring_buffer_num_items(buffer))
@@ -11,6 +11,19 @@
 
 #define RING_BUFFER_ASSERT(x) assert(x)
 
+/**
+ * /(SPSC)ģʽʹõڴϡ
+ * дٷͷ(release)ȶͷٶ(acquire)
+ * β෴RV32 ʹ fence ָƽ̨˻Ϊϡ
+ */
+#if defined(__riscv)
+#define RING_BUFFER_FENCE_RELEASE() __asm__ volatile("fence rw, w" ::: "memory")
+#define RING_BUFFER_FENCE_ACQUIRE() __asm__ volatile("fence r, rw" ::: "memory")
+#else
+#define RING_BUFFER_FENCE_RELEASE() __sync_synchronize()
+#define RING_BUFFER_FENCE_ACQUIRE() __sync_synchronize()
+#endif
+
 /**
  * buffer_sizeǷǶݡ
  * ƣֻ <tt> RING_BUFFER_SIZE-1 </tt> Ŀ
@@ -49,10 +62,12 @@ struct ring_buffer_t
   char *buffer;
   /** 롣 */
   ring_buffer_size_t buffer_mask;
-  /** β */
-  ring_buffer_size_t tail_index;
-  /** ͷ */
-  ring_buffer_size_t head_index;
+  /** βSPSC ģʽֻд */
+  volatile ring_buffer_size_t tail_index;
+  /** ͷSPSC ģʽֻд */
+  volatile ring_buffer_size_t head_index;
+  /** SPSC ģʽ򻺳ֻֽд */
+  volatile ring_buffer_size_t overflow_count;
 };
 
 /**
@@ -74,6 +89,8 @@ void ring_buffer_queue(ring_buffer_t *buffer, char data);
 
 /**
  * λһֽ顣
+ * ƻصǰο鿽ͷֻһΡ
+ * ռ䲻ʱֽͬϵݡ
  * @param buffer ҪݵĻ
  * @param data ָҪеָֽ롣
  * @param size ĴС
@@ -90,6 +107,7 @@ uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data);
 
 /**
  * ػλϵ <em>len</em> ֽڡ
+ * ƻصǰο鿽βֻһΡ
  * @param buffer ҪзݵĻ
  * @param data ָӦݵָ롣
  * @param len Ҫصֽ
@@ -97,6 +115,90 @@ uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data);
  */
 ring_buffer_size_t ring_buffer_dequeue_arr(ring_buffer_t *buffer, char *data, ring_buffer_size_t len);
 
+/**
+ * /(SPSC)ģʽ
+ * (紮ڽж)ֻ *_spsc Ӻֻдͷ
+ * (ѭ)ֻ *_spsc ĳӺֻдβ
+ * ÿֻһдߣ˫жϡʱݲۼ overflow_count
+ *  ring_buffer_queue() ߸дβ
+ * ͬһҪ SPSC ͨ/Ӻ
+ */
+
+/**
+ * SPSC ģʽλһֽ(ߵ)
+ * @param buffer ҪݵĻ
+ * @param data Ҫõֽڡ
+ * @return ɹΪ1ֽڱΪ0
+ */
+uint8_t ring_buffer_queue_spsc(ring_buffer_t *buffer, char data);
+
+/**
+ * SPSC ģʽλһֽ(ߵ)
+ * ռ䲻ʱֻܷµĲ֣ඪ overflow_count
+ * @param buffer ҪݵĻ
+ * @param data ָҪеָֽ롣
+ * @param size ĴС
+ * @return ʵʷֽ
+ */
+ring_buffer_size_t ring_buffer_queue_arr_spsc(ring_buffer_t *buffer, const char *data, ring_buffer_size_t size);
+
+/**
+ * SPSC ģʽػλϵֽ(ߵ)
+ * @param buffer ҪзݵĻ
+ * @param data ָӦλõָ롣
+ * @return Ϊ1Ϊ0
+ */
+uint8_t ring_buffer_dequeue_spsc(ring_buffer_t *buffer, char *data);
+
+/**
+ * SPSC ģʽػλϵ <em>len</em> ֽ(ߵ)
+ * @param buffer ҪзݵĻ
+ * @param data ָӦݵָ롣
+ * @param len Ҫصֽ
+ * @return صֽ
+ */
+ring_buffer_size_t ring_buffer_dequeue_arr_spsc(ring_buffer_t *buffer, char *data, ring_buffer_size_t len);
+
+/**
+ * 㿽д()
+ * ring_buffer_read_span() βһɶݣ
+ *     ԭؽ ring_buffer_read_advance() ͷõֽڡ
+ * дring_buffer_write_span() ͷһпռ䣬
+ *     (DMA)ԭݺ ring_buffer_write_commit() 
+ * ݿԽ洢ĩβʱΣһκȡһμɵõڶΡ
+ * ֻдβдֻдͷ *_spsc  SPSC ģʽ
+ */
+
+/**
+ * ȡһɶ(ߵ)
+ * @param buffer ҪȡĻ
+ * @param data ָɶʼλõָ롣
+ * @return ɶֽΪ0ʱΪա
+ */
+ring_buffer_size_t ring_buffer_read_span(ring_buffer_t *buffer, char **data);
+
+/**
+ * ͷѶȡֽڣβǰ(ߵ)
+ * @param buffer ҪͷݵĻ
+ * @param len ͷŵֽó ring_buffer_read_span() صĳȡ
+ */
+void ring_buffer_read_advance(ring_buffer_t *buffer, ring_buffer_size_t len);
+
+/**
+ * ȡһпռ(ߵ)
+ * @param buffer ҪдĻ
+ * @param data ָпռʼλõָ롣
+ * @return дֽΪ0ʱ
+ */
+ring_buffer_size_t ring_buffer_write_span(ring_buffer_t *buffer, char **data);
+
+/**
+ * дֽڣͷǰ(ߵ)
+ * @param buffer ҪݵĻ
+ * @param len ֽó ring_buffer_write_span() صĳȡ
+ */
+void ring_buffer_write_commit(ring_buffer_t *buffer, ring_buffer_size_t len);
+
 /**
  * 鿴λһԪضƳ
  * @param buffer ҪзݵĻ
@@ -136,4 +238,124 @@ inline ring_buffer_size_t ring_buffer_num_items(ring_buffer_t *buffer)
   return ((buffer->head_index - buffer->tail_index) & RING_BUFFER_MASK(buffer));
 }
 
+/**
+ * Ԫ͵Ļλģ(SPSC ģʽ)
+ * <tt>RING_DEFINE(name, type, size)</tt>  <tt>name##_t</tt> Լһ static inline 
+ * <tt>name##_init / name##_queue / name##_dequeue / name##_peek / name##_is_empty / name##_is_full / name##_num_items</tt>
+ * Լ㿽 <tt>name##_write_slot / name##_write_commit / name##_read_slot / name##_read_advance</tt>
+ * (ֱڶд洢д/ʹԪأύ/ͷ)
+ * 洢ǶڽṹУСΪڳ/ӰԪ帳ֵֻ輸ָ
+ *  *_spsc ֻͬдͷֻдβʱԪء
+ * size Ƕ(뱨) size-1 Ԫء
+ *
+ * ʾ
+ * @code
+ * typedef struct { int16_t speed; uint8_t dir; } motor_cmd_t;
+ * RING_DEFINE(motor_cmd_ring, motor_cmd_t, 8)          //  motor_cmd_ring_t 
+ * static motor_cmd_ring_t s_cmd_ring;
+ *
+ * motor_cmd_ring_init(&s_cmd_ring);
+ * motor_cmd_ring_queue(&s_cmd_ring, &cmd);             // (紮ڽ)
+ * while (motor_cmd_ring_dequeue(&s_cmd_ring, &cmd)) {} // ()
+ * @endcode
+ */
+#define RING_DEFINE(name, type, size)                                                                 \
+  typedef char name##_size_must_be_power_of_two[RING_BUFFER_IS_POWER_OF_TWO(size) ? 1 : -1];         \
+  typedef struct                                                                                      \
+  {                                                                                                   \
+    type buffer[(size)];                                                                              \
+    volatile ring_buffer_size_t tail_index;                                                           \
+    volatile ring_buffer_size_t head_index;                                                           \
+    volatile ring_buffer_size_t overflow_count;                                                       \
+  } name##_t;                                                                                         \
+                                                                                                      \
+  static inline void name##_init(name##_t *rb)                                                        \
+  {                                                                                                   \
+    rb->tail_index = 0;                                                                               \
+    rb->head_index = 0;                                                                               \
+    rb->overflow_count = 0;                                                                           \
+  }                                                                                                   \
+                                                                                                      \
+  static inline ring_buffer_size_t name##_num_items(const name##_t *rb)                               \
+  {                                                                                                   \
+    return ((rb->head_index - rb->tail_index) & ((size) - 1));                                        \
+  }                                                                                                   \
+                                                                                                      \
+  static inline uint8_t name##_is_empty(const name##_t *rb)                                           \
+  {                                                                                                   \
+    return (rb->head_index == rb->tail_index);                                                        \
+  }                                                                                                   \
+                                                                                                      \
+  static inline uint8_t name##_is_full(const name##_t *rb)                                            \
+  {                                                                                                   \
+    return (name##_num_items(rb) == ((size) - 1));                                                    \
+  }                                                                                                   \
+                                                                                                      \
+  static inline uint8_t name##_queue(name##_t *rb, const type *data)                                  \
+  {                                                                                                   \
+    ring_buffer_size_t head = rb->head_index;                                                         \
+    ring_buffer_size_t next = ((head + 1) & ((size) - 1));                                            \
+    if (next == rb->tail_index)                                                                       \
+    {                                                                                                 \
+      rb->overflow_count++;                                                                           \
+      return 0;                                                                                       \
+    }                                                                                                 \
+    RING_BUFFER_FENCE_ACQUIRE();                                                                      \
+    rb->buffer[head] = *data;                                                                         \
+    RING_BUFFER_FENCE_RELEASE();                                                                      \
+    rb->head_index = next;                                                                            \
+    return 1;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline uint8_t name##_dequeue(name##_t *rb, type *data)                                      \
+  {                                                                                                   \
+    ring_buffer_size_t tail = rb->tail_index;                                                         \
+    if (rb->head_index == tail)                                                                       \
+    {                                                                                                 \
+      return 0;                                                                                       \
+    }                                                                                                 \
+    RING_BUFFER_FENCE_ACQUIRE();                                                                      \
+    *data = rb->buffer[tail];                                                                         \
+    RING_BUFFER_FENCE_RELEASE();                                                                      \
+    rb->tail_index = ((tail + 1) & ((size) - 1));                                                     \
+    return 1;                                                                                         \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_peek(name##_t *rb, ring_buffer_size_t index)                             \
+  {                                                                                                   \
+    if (index >= name##_num_items(rb))                                                                \
+    {                                                                                                 \
+      return NULL;                                                                                    \
+    }                                                                                                 \
+    RING_BUFFER_FENCE_ACQUIRE();                                                                      \
+    return &rb->buffer[(rb->tail_index + index) & ((size) - 1)];                                      \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_write_slot(name##_t *rb)                                                 \
+  {                                                                                                   \
+    if (name##_is_full(rb))                                                                           \
+    {                                                                                                 \
+      return NULL;                                                                                    \
+    }                                                                                                 \
+    RING_BUFFER_FENCE_ACQUIRE();                                                                      \
+    return &rb->buffer[rb->head_index];                                                               \
+  }                                                                                                   \
+                                                                                                      \
+  static inline void name##_write_commit(name##_t *rb)                                                \
+  {                                                                                                   \
+    RING_BUFFER_FENCE_RELEASE();                                                                      \
+    rb->head_index = ((rb->head_index + 1) & ((size) - 1));                                           \
+  }                                                                                                   \
+                                                                                                      \
+  static inline type *name##_read_slot(name##_t *rb)                                                  \
+  {                                                                                                   \
+    return name##_peek(rb, 0);                                                                        \
+  }                                                                                                   \
+                                                                                                      \
+  static inline void name##_read_advance(name##_t *rb)                                                \
+  {                                                                                                   \
+    RING_BUFFER_FENCE_RELEASE();                                                                      \
+    rb->tail_index = ((rb->tail_index + 1) & ((size) - 1));                                           \
+  }
+
 #endif /* RINGBUFFER_H */
@@ -33,22 +33,199 @@ motor_recip_instance_t P_M1_instance = {
     .brake = motor1_step_instance_brake,
     .name = "M1"};
 
+// 往复运动参数，在参数表(Param_frame)中可调
+uint16_t motor_pwm = 100;              // 往复运动PWM占空比
+uint16_t motor_forward_ms = 1000;      // 往复运动正转时间
+uint16_t motor_backward_ms = 600;      // 往复运动反转时间
+uint16_t motor_cooldown_ms = 100;      // 往复运动冷却时间
+
+// 整机累计计数，保存在片内Flash键值存储中，上电恢复
+#define KV_KEY_M1_START_COUNT 0 // 电机1启动次数
+#define KV_KEY_M1_RUN_MS 1      // 电机1累计运行时间(ms)
+uint32_t M1_start_count = 0;
+uint32_t M1_run_ms = 0;
+
+#if MOTION_LOG_USE_W25Q32
+static uint32_t Motion_Log_Time(void)
+{
+    return (uint32_t)XxxTimeSliceOffset_GetTick();
+}
+#endif
+/**
+ *  @brief 记录一条运动事件并唤醒日志写入任务
+ */
+static void Motion_Log_Record(uint8_t type, uint16_t arg, int32_t value)
+{
+#if MOTION_LOG_USE_W25Q32
+    Motion_Log_Event(type, arg, value);
+    XxxTimeSliceOffset_Resume(&Motion_log_task);
+#else
+    (void)type;
+    (void)arg;
+    (void)value;
+#endif
+}
+
+/**
+ *  @brief 启动电机1往复运动并累计启动次数
+ *  @return 电机空闲且已接受返回true
+ */
+static bool Motor1_Recip_Start(uint16_t pwm)
+{
+    if (!motor_recip_instance_start(&P_M1_instance, pwm, motor_forward_ms, motor_backward_ms, motor_cooldown_ms))
+    {
+        return false;
+    }
+    M1_start_count++;
+    Motion_Log_Record(MOTION_LOG_START, pwm, (int32_t)M1_start_count);
+    return true;
+}
+
+/**
+ *  @brief 停止电机1，运行中停止时记录事件
+ */
+static void Motor1_Recip_Stop(void)
+{
+    if (P_M1_instance.state != MOTOR_RECIP_STATE_IDLE)
+    {
+        Motion_Log_Record(MOTION_LOG_STOP, P_M1_instance.state, (int32_t)M1_run_ms);
+    }
+    motor_recip_instance_stop(&P_M1_instance);
+}
+
 void motor_step_update_task(void)
 {
-    motor_recip_update(&P_M1_instance, 10);
+    static uint8_t last_state = MOTOR_RECIP_STATE_IDLE;
+    if (P_M1_instance.state != MOTOR_RECIP_STATE_IDLE)
+    {
+        M1_run_ms += Motor_task.reloadVal;
+    }
+    motor_recip_update(&P_M1_instance, Motor_task.reloadVal); // 经过时间取任务周期，修改周期后无需同步修改
+    if (P_M1_instance.state != last_state)
+    {
+        last_state = P_M1_instance.state;
+        Motion_Log_Record(MOTION_LOG_STATE, last_state, (int32_t)M1_run_ms);
+    }
+}
+
+/**
+ *  @brief 累计计数保存任务，5s一次，计数没变化时不写Flash
+ */
+void Counter_Checkpoint_Task(void)
+{
+    KV_Put(KV_KEY_M1_START_COUNT, &M1_start_count, sizeof(M1_start_count));
+    KV_Put(KV_KEY_M1_RUN_MS, &M1_run_ms, sizeof(M1_run_ms));
 }
 //!------------------🍅🍅🍅🍅🍅🍅 注册时间片轮询任务 START 🍒🍒🍒🍒🍒🍒---------⬇️⬇️⬇️⬇️⬇️⬇️
-STR_XxxTimeSliceOffset Uart_task, Motor_task, While_task; // 创建任务句柄,While_task,Key_task,
+STR_XxxTimeSliceOffset Uart_task, Motor_task, While_task, Telemetry_task, Counter_task, Motion_log_task, Balance_task; // 创建任务句柄,While_task,Key_task,
+/**
+ *  @brief 软、硬实时任务耗时测量用的时间戳，TIM5 1us计数
+ */
+static unsigned short Time_Slice_Timestamp(void)
+{
+    return timer_get(TIM_5);
+}
+
+#define TICKLESS_UNITS_PER_TICK 100 // 无节拍空闲时TIM6按10us计数，每个tick 100个计数
+#define TICKLESS_MAX_TICKS 600       // 无节拍空闲单次最长睡眠tick数，自动重装载值不超过16位
+/**
+ *  @brief 时间片调度空闲钩子，没有任务可运行时调用
+ *  @param idleTicks 距最近一个定时任务到期的tick数
+ *  @note  先屏蔽中断再复查是否可以空闲，睡眠期间保持屏蔽(挂起的中断仍会唤醒WFI)，醒来后才开中断执行中断服务函数，
+ *         复查之后中断恢复的任务不会等到下一次唤醒才运行；
+ *         不足2个tick时只执行WFI等待下一次中断；否则把TIM6改为idleTicks个tick后唤醒(无节拍空闲)，
+ *         从上一个tick起计时，醒来后按实际睡眠时间补偿tick，不足1ms的部分写回恢复后的1ms节拍计数器，
+ *         不足一个计数的时钟周期留到下一次，频繁被其他中断唤醒时tick也不会漂移或停走
+ */
+static void Time_Slice_Idle(unsigned short idleTicks)
+{
+    static uint32 idle_residual = 0; // 换算计数时不足一个计数的系统时钟周期数，带到下一次
+    uint32 primask = interrupt_global_disable();
+
+    idleTicks = XxxTimeSliceOffset_GetIdleTicks(); // 屏蔽中断后复查，检查之后中断恢复了任务则不睡眠
+    if (0 == idleTicks)
+    {
+        interrupt_global_enable(primask);
+        return;
+    }
+    if (idleTicks < 2)
+    {
+        __WFI(); // 下一个tick就有任务到期，只睡到下一次中断
+        interrupt_global_enable(primask);
+        return;
+    }
+    if (idleTicks > TICKLESS_MAX_TICKS)
+    {
+        idleTicks = TICKLESS_MAX_TICKS;
+    }
+
+    uint16 psc = TIM6->PSC; // 保存1ms节拍配置
+    uint16 arr = TIM6->ATRLR;
+    uint32 tick_cycles = (uint32)(arr + 1) * (psc + 1);                    // 1ms节拍的系统时钟周期数
+    uint32 unit_cycles = system_clock / (1000 * TICKLESS_UNITS_PER_TICK);  // 睡眠时一个计数的系统时钟周期数
+
+    TIM_Cmd(TIM6, DISABLE);
+    if (TIM_GetITStatus(TIM6, TIM_IT_Update) != RESET) // 刚到一个tick，中断尚未执行，先让节拍中断处理
+    {
+        TIM_Cmd(TIM6, ENABLE);
+        interrupt_global_enable(primask);
+        return;
+    }
+    uint32 since_tick = (uint32)TIM_GetCounter(TIM6) * (psc + 1) + idle_residual; // 距上一个tick的时钟周期数
+    TIM_UpdateRequestConfig(TIM6, TIM_UpdateSource_Regular);                       // 软件更新不产生中断
+    TIM_PrescalerConfig(TIM6, unit_cycles - 1, TIM_PSCReloadMode_Immediate);      // 10us计数
+    TIM_SetAutoreload(TIM6, idleTicks * TICKLESS_UNITS_PER_TICK - 1);
+    TIM_SetCounter(TIM6, (uint16)(since_tick / unit_cycles));                      // 从上一个tick起计时，到期时刻对齐tick
+    since_tick %= unit_cycles;
+    TIM_ClearITPendingBit(TIM6, TIM_IT_Update);
+    TIM_Cmd(TIM6, ENABLE);
+
+    __WFI(); // 睡眠，到期或其他中断唤醒
+
+    TIM_Cmd(TIM6, DISABLE);
+    uint32 units = TIM_GetCounter(TIM6); // 距上一个tick的计数
+    if (TIM_GetITStatus(TIM6, TIM_IT_Update) != RESET) // 已到期，计数器已回绕
+    {
+        TIM_ClearITPendingBit(TIM6, TIM_IT_Update);
+        units += (uint32)idleTicks * TICKLESS_UNITS_PER_TICK;
+    }
+    uint32 elapsed = units * unit_cycles + since_tick + unit_cycles / 2; // 停止时分频器内的计数读不出，按半个计数计
+    XxxTimeSliceOffset_Compensate((unsigned short)(elapsed / tick_cycles)); // 屏蔽中断期间节拍中断没有执行，全部由补偿推进
+    elapsed %= tick_cycles;
+
+    // 恢复1ms节拍
+    TIM_PrescalerConfig(TIM6, psc, TIM_PSCReloadMode_Immediate);
+    TIM_SetAutoreload(TIM6, arr);
+    TIM_SetCounter(TIM6, (uint16)(elapsed / (psc + 1)));
+    idle_residual = elapsed % (psc + 1);
+    TIM_ClearITPendingBit(TIM6, TIM_IT_Update);
+    TIM_UpdateRequestConfig(TIM6, TIM_UpdateSource_Global);
+    TIM_Cmd(TIM6, ENABLE);
+    interrupt_global_enable(primask);
+}
 /**
  *  @brief 时间片轮询任务创建函数
  *  @note 记得创建任务句柄
  */
 void Time_Slice_Offset_Register(void)
 {
+    XxxTimeSliceOffset_SetTimestamp(Time_Slice_Timestamp); // 测量任务耗时，供自动错位使用
+    XxxHardRealTime_SetTimestamp(Time_Slice_Timestamp);    // 测量硬实时任务耗时，用于超时统计
+    XxxTimeSliceOffset_SetIdleHook(Time_Slice_Idle);       // 空闲时睡眠，不再忙等
+    XxxTimeSliceOffset_SetCriticalHook(interrupt_global_disable, interrupt_global_enable); // 注册/注销修改链表时屏蔽中断
+    // XxxHardRealTime_Register(&Current_loop, Current_Loop, 1, 15); // 注册硬实时任务，每个TIM7节拍执行，预算15us
     // !任务调度系统节拍 单位 10 ms 以下是注册任务
-    XxxTimeSliceOffset_Register(&While_task, While_Task, 10, 0);             // 注册while循环任务。
-    XxxTimeSliceOffset_Register(&Uart_task, UART_packet_TASKhandler, 0, 0);  // 注册串口数据包接收任务, 轮询时间为0即while，偏移0.
-    XxxTimeSliceOffset_Register(&Motor_task, motor_step_update_task, 10, 0); // 注册电机步进任务, 轮询时间为1ms，偏移0.
+    XxxTimeSliceOffset_Register(&While_task, While_Task, 10, XXXTIMESLICEOFFSET_OFFSET_AUTO);             // 注册while循环任务，自动错位。
+    XxxTimeSliceOffset_Register(&Uart_task, UART_packet_TASKhandler, 0, 0);                               // 注册串口数据包接收任务, 轮询时间为0即while，偏移0.
+    XxxTimeSliceOffset_Register(&Motor_task, motor_step_update_task, 10, XXXTIMESLICEOFFSET_OFFSET_AUTO); // 注册电机步进任务, 轮询时间为10ms，自动错位.
+    XxxTimeSliceOffset_Register(&Telemetry_task, Telemetry_Task, 1, XXXTIMESLICEOFFSET_OFFSET_AUTO);      // 注册遥测采样任务，1ms，自动错位，遥测关闭时挂起
+    XxxTimeSliceOffset_Suspend(&Telemetry_task);                                                           // 默认关闭，由遥测速率命令打开
+    XxxTimeSliceOffset_Register(&Counter_task, Counter_Checkpoint_Task, 5000, 3); // 注册累计计数保存任务，5s，周期大于错位窗口，手动偏移3
+    XxxTimeSliceOffset_Register(&Motion_log_task, Motion_Log_Task, 1, XXXTIMESLICEOFFSET_OFFSET_AUTO);         // 注册运动日志写入任务，1ms，自动错位，没有待写记录时挂起
+#if !MOTION_LOG_USE_W25Q32
+    XxxTimeSliceOffset_Suspend(&Motion_log_task);
+#endif
+    XxxTimeSliceOffset_Register(&Balance_task, Time_Slice_Balance_Task, 1000, 7);   // 注册错位重新分配任务，1s，手动偏移7(与计数保存任务错开)，实测耗时变化时按实测值重新分配自动错位
     // XxxTimeSliceOffset_Register(&Key_task, key_Processing, 2, 1);           // 按键扫描函数,需要使用记得注册任务以及初始化 key_init(20);
     //  注册任务结束
 }
@@ -64,6 +241,201 @@ PacketTag_TpDef_struct Test_packet[] = {
     {"2", UnpackData_Handle_Float_FireWater, &test_value_2},
     // 添加更多的映射关系
 };
+
+// 运行控制量，上位机写入，不掉电保存(非0时While_Task会启动电机，上电恢复会让电机自行转动)
+PacketFrame_TpDef_struct Test_frame[] = {
+    {1, BINFRAME_TYPE_I32, &test_value_1},
+};
+
+// 参数表，上位机读写，改动自动保存到Flash，上电恢复
+PacketFrame_TpDef_struct Param_frame[] = {
+    {2, BINFRAME_TYPE_F32, &test_value_2},
+    {3, BINFRAME_TYPE_U16, &motor_pwm},
+    {4, BINFRAME_TYPE_U16, &motor_forward_ms},
+    {5, BINFRAME_TYPE_U16, &motor_backward_ms},
+    {6, BINFRAME_TYPE_U16, &motor_cooldown_ms},
+    // 添加更多的映射关系
+};
+
+static bool M1_command_run = false; // 命令启动的单次往复运动进行中，期间While_Task不按test_value_1启停电机
+
+/**
+ *  @brief 电机往复运动启动命令，数值为PWM占空比
+ *  @return 电机空闲且已接受返回true(ACK)，电机正在运行返回false(NACK)
+ *  @note  按命令给出的PWM运行一个往复周期后停止，不改动调参变量test_value_1、motor_pwm
+ */
+static bool Cmd_Motor_Recip_Start(const void *value)
+{
+    uint16_t pwm = *(const uint16_t *)value;
+    if (!Motor1_Recip_Start(pwm))
+    {
+        return false;
+    }
+    M1_command_run = true;
+    XxxTimeSliceOffset_Resume(&Motor_task);
+    return true;
+}
+/**
+ *  @brief 电机往复运动停止命令，数值忽略
+ */
+static bool Cmd_Motor_Recip_Stop(const void *value)
+{
+    (void)value;
+    M1_command_run = false;
+    test_value_1 = 0; // While_Task随后挂起电机任务，也不再按调参方式重新启动
+    Motor1_Recip_Stop();
+    return true;
+}
+
+static Telemetry_Channel_TpDef_struct M1_telemetry; // 电机1状态遥测通道
+
+/**
+ *  @brief 遥测速率命令，数值为抽取比：每N个1ms采一个样本，0关闭
+ *  @note  关闭时挂起遥测任务，不影响空闲睡眠
+ */
+static bool Cmd_Telemetry_Rate(const void *value)
+{
+    uint16_t decimation = *(const uint16_t *)value;
+    Telemetry_Set_Rate(&M1_telemetry, decimation);
+    if (decimation)
+    {
+        XxxTimeSliceOffset_Resume(&Telemetry_task);
+    }
+    else
+    {
+        XxxTimeSliceOffset_Suspend(&Telemetry_task);
+        Telemetry_Flush(&M1_telemetry); // 发出剩余样本
+    }
+    return true;
+}
+/**
+ *  @brief 遥测字段命令，数值为字段掩码(Telemetry_Field_enum)
+ */
+static bool Cmd_Telemetry_Fields(const void *value)
+{
+    uint8_t mask = *(const uint8_t *)value;
+    if (0 == (mask & TELEMETRY_FIELD_ALL))
+    {
+        return false;
+    }
+    Telemetry_Set_Fields(&M1_telemetry, mask);
+    return true;
+}
+
+/**
+ *  @brief 运动日志导出命令，数值为导出最近的记录数，0为全部
+ *  @return 正在导出或没有日志时返回false(NACK)
+ *  @note  日志帧(标签 MOTION_LOG_FRAME_TAG)从遥测同一端口发出，空载荷帧表示导出结束
+ */
+static bool Cmd_Motion_Log_Dump(const void *value)
+{
+#if MOTION_LOG_USE_W25Q32
+    if (!Motion_Log_Dump(M1_telemetry.port, MOTION_LOG_FRAME_TAG, *(const uint32_t *)value))
+    {
+        return false;
+    }
+    XxxTimeSliceOffset_Resume(&Motion_log_task);
+    return true;
+#else
+    (void)value;
+    return false;
+#endif
+}
+
+// 需要确认结果的命令，用请求帧(BINFRAME_TYPE_REQUEST)发送，回ACK/NACK响应帧
+PacketFrame_TpDef_struct Motor_command[] = {
+    {10, BINFRAME_TYPE_U16, NULL, Cmd_Motor_Recip_Start},
+    {11, BINFRAME_TYPE_U8, NULL, Cmd_Motor_Recip_Stop},
+    {20, BINFRAME_TYPE_U16, NULL, Cmd_Telemetry_Rate},
+    {21, BINFRAME_TYPE_U8, NULL, Cmd_Telemetry_Fields},
+    {22, BINFRAME_TYPE_U32, NULL, Cmd_Motion_Log_Dump},
+};
+
+#if PROTOCOL_USE_CDC_PORT
+static ring_buffer_t cdc_rx_ring;
+static char cdc_rx_place[PROTOCOL_PORT_RX_SIZE];
+static Protocol_Port_TpDef_struct cdc_port; // USB CDC协议端口
+/**
+ *  @brief USB CDC端口发送函数，端点一次最多63字节，分包发送
+ */
+static void CDC_Port_Write(const uint8_t *data, uint16_t len)
+{
+    while (len)
+    {
+        uint16_t n = (len > 63) ? 63 : len;
+        cdc_send_pack(data, n);
+        data += n;
+        len -= n;
+    }
+}
+/**
+ *  @brief USB CDC接收回调，在USB中断中把数据送入端口并恢复串口数据包任务
+ */
+static void CDC_Port_Receive(const uint8 *p, uint32 length)
+{
+    Protocol_Port_Feed(&cdc_port, p, (uint16_t)length);
+    XxxTimeSliceOffset_Resume(&Uart_task);
+}
+#endif
+
+#if PROTOCOL_USE_WIRELESS_PORT
+static ring_buffer_t wireless_rx_ring;
+static char wireless_rx_place[PROTOCOL_PORT_RX_SIZE];
+static uint8 wireless_tx_queue[WIRELESS_PORT_TX_SIZE]; // UART7异步发送队列
+static Protocol_Port_TpDef_struct wireless_port; // 无线串口协议端口
+/**
+ *  @brief 无线串口端口发送函数，放入UART7异步发送队列后立即返回，由发送中断发出
+ *  @note  放不下的部分丢弃；端口发送前先用 Wireless_Port_Tx_Free 确认整帧放得下
+ */
+static void Wireless_Port_Write(const uint8_t *data, uint16_t len)
+{
+    uart_write_buffer_async(WIRELESS_UART_INDEX, data, len);
+}
+/**
+ *  @brief 无线串口端口发送空间查询
+ *  @note  模块RTS为高(模块缓冲区满)时返回0，让遥测、日志导出等下一轮再发
+ */
+static uint16_t Wireless_Port_Tx_Free(void)
+{
+    if (gpio_get_level(WIRELESS_UART_RTS_PIN))
+    {
+        return 0;
+    }
+    return (uint16_t)uart_tx_async_free(WIRELESS_UART_INDEX);
+}
+/**
+ *  @brief 把无线串口驱动FIFO中的数据送入端口
+ */
+static void Wireless_Port_Poll(void)
+{
+    uint8 buffer[32];
+    uint32 n = 0;
+    while ((n = wireless_uart_read_buffer(buffer, sizeof(buffer))) != 0)
+    {
+        if (Protocol_Port_Feed(&wireless_port, buffer, (uint16_t)n) < n)
+        {
+            break; // 端口缓冲区满，溢出计入 overflow_count
+        }
+    }
+}
+#endif
+
+/**
+ *  @brief 除DEBUG_UART外的协议端口是否还有未处理的数据
+ *  @note  在挂起串口任务后调用；无线串口驱动FIFO没有接收通知，先取一次到端口缓冲区再判断
+ */
+static bool Protocol_Ports_Pending(void)
+{
+    bool pending = false;
+#if PROTOCOL_USE_CDC_PORT
+    pending |= Protocol_Port_Pending(&cdc_port);
+#endif
+#if PROTOCOL_USE_WIRELESS_PORT
+    Wireless_Port_Poll();
+    pending |= Protocol_Port_Pending(&wireless_port);
+#endif
+    return pending;
+}
 //!------------------✨✨✨✨✨✨ 串口数据包任务使用的 END 🌸🌸🌸🌸🌸🌸---------⬆️⬆️⬆️⬆️⬆️⬆️
 
 //!------------------🍅🍅🍅🍅🍅🍅 非时间片轮询任务调度函数 START  🍒🍒🍒🍒🍒🍒---------⬇️⬇️⬇️⬇️⬇️⬇️
@@ -77,14 +449,46 @@ PacketTag_TpDef_struct Test_packet[] = {
 void PeripheraAll_Init()
 {
     UART_DEBUG_Init();
+    PacketTag_Register(Test_packet, NumOfMsg);  // 建立文本标签散列表
+    PacketFrame_Register(Test_frame, sizeof(Test_frame) / sizeof(Test_frame[0]));  // 运行控制量只登记到标签索引表，不保存
+    Param_Register(Param_frame, sizeof(Param_frame) / sizeof(Param_frame[0])); // 参数表登记到二进制帧标签索引表(所有协议端口共用)并掉电保存
+    uint16_t restored = Param_Load();                                        // 从Flash恢复参数
+    KV_Init();                                                               // 挂载键值存储，恢复累计计数
+    KV_Get(KV_KEY_M1_START_COUNT, &M1_start_count, sizeof(M1_start_count));
+    KV_Get(KV_KEY_M1_RUN_MS, &M1_run_ms, sizeof(M1_run_ms));
+#if MOTION_LOG_USE_W25Q32
+    if (0 == w25q32_init() && Motion_Log_Init(Motion_Log_Time)) // 外部Flash运动日志，接着上次的位置写
+    {
+        Motion_Log_Record(MOTION_LOG_BOOT, 0, (int32_t)M1_start_count);
+    }
+#endif
+    PacketFrame_Register(Motor_command, sizeof(Motor_command) / sizeof(Motor_command[0])); // 电机命令，请求帧回ACK/NACK
+#if PROTOCOL_USE_CDC_PORT
+    Protocol_Port_Init(&cdc_port, "CDC", &cdc_rx_ring, cdc_rx_place, PROTOCOL_PORT_RX_SIZE, CDC_Port_Write);
+    cdc_set_rx_callback(CDC_Port_Receive);
+    usb_cdc_init();
+#endif
+#if PROTOCOL_USE_WIRELESS_PORT
+    Protocol_Port_Init(&wireless_port, "WIRELESS", &wireless_rx_ring, wireless_rx_place, PROTOCOL_PORT_RX_SIZE, Wireless_Port_Write);
+    Protocol_Port_Set_Tx_Free(&wireless_port, Wireless_Port_Tx_Free);
+    wireless_uart_init();
+    uart_tx_async_init(WIRELESS_UART_INDEX, wireless_tx_queue, sizeof(wireless_tx_queue), NULL); // 在uart_init之后启用异步发送
+#endif
+    Telemetry_Bind_Recip(&M1_telemetry, &P_M1_instance); // 电机1状态遥测，默认关闭，由命令标签20/21设置速率和字段
+#if TELEMETRY_USE_CDC_PORT && PROTOCOL_USE_CDC_PORT
+    Telemetry_Config(&M1_telemetry, &cdc_port, TELEMETRY_FRAME_TAG, TELEMETRY_FIELD_STATE | TELEMETRY_FIELD_TIMER_MS | TELEMETRY_FIELD_PWM, 0);
+#else
+    Telemetry_Config(&M1_telemetry, &UART_DEBUG_port, TELEMETRY_FRAME_TAG, TELEMETRY_FIELD_STATE | TELEMETRY_FIELD_TIMER_MS | TELEMETRY_FIELD_PWM, 0);
+#endif
 
     pit_ms_init(TIM6_PIT, 1);             // 定时器6初始化，提供软实时任务调度系统节拍
     interrupt_set_priority(TIM6_IRQn, 0); // 最高中断优先级
 
-    // pit_ms_init(TIM7_PIT, 50);            // 定时器七初始化，用于硬实时任务调度
+    // pit_us_init(TIM7_PIT, 50);            // 定时器七初始化，用于硬实时任务调度，20kHz节拍，注册硬实时任务后再打开
     // interrupt_set_priority(TIM7_IRQn, 0);
+    // interrupt_set_priority(TIM6_IRQn, (1 << 5)); // 打开硬实时后软实时节拍降一级抢占优先级，让TIM7可以打断TIM6
 
-    // timer_init(TIM_5, TIMER_US); // 初始化定时器5用于计时
+    timer_init(TIM_5, TIMER_US); // 初始化定时器5用于计时，时间片任务耗时测量
 
     gpio_init(E2, GPO, 0, GPIO_PIN_CONFIG); // 电机使能
     gpio_init(E3, GPO, 0, GPIO_PIN_CONFIG); // 电机正转
@@ -94,6 +498,7 @@ void PeripheraAll_Init()
     // key_init(20); // 按键初始化，20ms一次中断
     printf_USART_DEBUG("hello,WSY!\r\n");
     printf_USART_DEBUG("hello,WSY! Let`s start!\r\n");
+    printf_USART_DEBUG("param restored:%d free:%d\r\n", restored, Param_Free_Records());
     // Task_Disable();  // 定时器中断失能。即所有实时任务停止
 }
 //!------------------✨✨✨✨✨✨ 非时间片轮询任务调度函数 END 🌸🌸🌸🌸🌸🌸---------⬆️⬆️⬆️⬆️⬆️⬆️
@@ -106,29 +511,41 @@ void PeripheraAll_Init()
 void While_Task(void)
 {
     // 写入while循环任务
+    Param_Process(While_task.reloadVal); // 参数改动停止一段时间后保存到Flash
+    // 命令启动的单次运动期间不按test_value_1重启或停止电机，运动结束后再按调参方式处理
+    if (M1_command_run)
+    {
+        if (P_M1_instance.state != MOTOR_RECIP_STATE_IDLE)
+        {
+            return;
+        }
+        M1_command_run = false;
+    }
     // 当test_value_1大于零时，电机正转一次
-    uint16_t dirve_duration_ms = 100;
-    uint16_t cooldown_duration_ms = 100;
     if (test_value_1 > 0)
     {
-        motor_recip_instance_start(&P_M1_instance, 100, 1000, 600, 100);
+        XxxTimeSliceOffset_Resume(&Motor_task); // 电机运行时恢复电机任务
+        Motor1_Recip_Start(motor_pwm);
         printf_USART_DEBUG("forward\r\n");
     }
     // 当test_value_1小于零时，电机反转一次
     else if (test_value_1 < 0)
     {
-        motor_recip_instance_start(&P_M1_instance, 100, 1000, 600, 100);
+        XxxTimeSliceOffset_Resume(&Motor_task);
+        Motor1_Recip_Start(motor_pwm);
         printf_USART_DEBUG("backward\r\n");
     }
     else if (test_value_1 == 0)
     {
-        motor_recip_instance_stop(&P_M1_instance);
+        Motor1_Recip_Stop();
+        XxxTimeSliceOffset_Suspend(&Motor_task); // 电机停止后挂起电机任务，空闲时不占用CPU
         printf_USART_DEBUG("recip stop\r\n");
     }
 }
 /**
  *  @brief 串口数据包处理任务函数
  *  @note  务必设置为无定时任务，全速运行防止缓冲区溢出
+ *  @note  缓冲区处理完后挂起自身，由串口接收中断恢复，这样系统才能进入空闲睡眠
  */
 void UART_packet_TASKhandler(void)
 {
@@ -136,11 +553,74 @@ void UART_packet_TASKhandler(void)
     if (UART_DEBUG_data_packet_ready)
     {
         UART_DEBUG_data_packet_ready = false;
-        PacketTag_Analysis(Test_packet, NumOfMsg); // 此处NumOfMsg在串口处定义。
-        DebugPrint();                              // 输出接收的数据
+        if (UART_DEBUG_got_is_frame)
+        {
+            PacketFrame_Dispatch(&UART_DEBUG_got_frame); // 二进制帧按标签编号直接索引写入，批量帧整批写入并回一个应答帧
+        }
+        else
+        {
+            PacketTag_Dispatch_Batch((char *)UART_DEBUG_got_data); // 一包可含多个 标签=数值，分发后只回一行应答，不再逐条回显
+        }
         printf_USART_DEBUG("\r\ntestv1:%d\r\n", test_value_1);
         printf_USART_DEBUG("\r\ntestv2:%f\r\n", test_value_2);
     }
+#if PROTOCOL_USE_CDC_PORT
+    Protocol_Port_Process(&cdc_port); // 其他端口直接分发，批量帧应答从各自端口发回
+#endif
+#if PROTOCOL_USE_WIRELESS_PORT
+    Wireless_Port_Poll();
+    Protocol_Port_Process(&wireless_port);
+#endif
+    XxxTimeSliceOffset_Suspend(&Uart_task); // 先挂起再检查，避免漏掉挂起前中断刚放入的数据
+    if (UART_DEBUG_Packet_Pending() || Protocol_Ports_Pending()) // 缓冲区或包队列中还有数据，继续运行
+    {
+        XxxTimeSliceOffset_Resume(&Uart_task);
+    }
+}
+/**
+ *  @brief 电机状态遥测任务，1ms一次
+ *  @note  每次只采样入队(按抽取比)，每8ms打包发送一次，组帧和CRC不在每个采样点上执行；
+ *         需要更高采样率时把 Telemetry_Sample() 注册为硬实时任务(TIM7)，本任务只保留发送部分
+ */
+void Telemetry_Task(void)
+{
+    static uint8_t flush_divider = 0;
+    Telemetry_Sample(&M1_telemetry);
+    if (++flush_divider >= 8)
+    {
+        flush_divider = 0;
+        Telemetry_Flush(&M1_telemetry);
+    }
+}
+/**
+ *  @brief 运动日志写入任务，1ms一次
+ *  @note  每次只发起一个Flash操作(页编程、扇区擦除或导出一帧)后返回，不等待W25Q32忙；
+ *         没有待做的工作时挂起自身，由 Motion_Log_Record() 和导出命令恢复
+ */
+void Motion_Log_Task(void)
+{
+#if MOTION_LOG_USE_W25Q32
+    if (Motion_Log_Process())
+    {
+        return;
+    }
+#endif
+    XxxTimeSliceOffset_Suspend(&Motion_log_task);
+}
+/**
+ *  @brief 错位重新分配任务，1s一次
+ *  @note  注册时各任务耗时未知(按1计)，运行后测得的最大耗时有变化时调用 XxxTimeSliceOffset_Balance() 按实测耗时重新分配自动错位；
+ *         最大耗时只增不减，运行一段时间后不再变化，之后不再重新分配，任务相位保持不变
+ */
+void Time_Slice_Balance_Task(void)
+{
+    static unsigned long last_cost = 0;
+    unsigned long cost = (unsigned long)While_task.cost + Motor_task.cost + Telemetry_task.cost + Counter_task.cost + Motion_log_task.cost;
+    if (cost != last_cost)
+    {
+        last_cost = cost;
+        XxxTimeSliceOffset_Balance();
+    }
 }
 /**
  *  @brief 按键扫描、处理任务，默认20ms处理一次
@@ -170,10 +650,11 @@ void key_Processing(void)
  *  @brief 硬实时任务处理，到点就触发，比软实时任务高一级
  *  @param
  *  @return
- *  @note   此函数在TIM7中断中被使用，将函数写入此函数中即可。
- *  @warning
+ *  @note   此函数在TIM7中断中被使用，硬实时任务通过 XxxHardRealTime_Register 注册，按注册顺序执行。
+ *  @warning 硬实时任务在中断中执行，不可阻塞
  */
 void Hard_Real_Time_Processing(void)
 {
+    XxxHardRealTime_Produce();
 }
 //!------------------✨✨✨✨✨✨ 硬实时任务 END 🌸🌸🌸🌸🌸🌸---------⬆️⬆️⬆️⬆️⬆️⬆️
\ No newline at end of file
@@ -4,13 +4,34 @@
 #include "zf_common_headfile.h"
 
 //---------时间片轮询任务调度的变量 START
+extern STR_XxxTimeSliceOffset Uart_task, Motor_task, While_task, Telemetry_task, Counter_task, Motion_log_task, Balance_task; // 任务句柄，可用于挂起/恢复/修改周期
 //---------时间片轮询任务调度的变量 END
 
+//---------协议引擎端口 START
+#define PROTOCOL_USE_CDC_PORT (0)      // 1 USB CDC作为协议端口，与DEBUG_UART共用标签表
+#define PROTOCOL_USE_WIRELESS_PORT (0) // 1 无线串口(UART7)作为协议端口，与DEBUG_UART共用标签表
+#define PROTOCOL_PORT_RX_SIZE 256      // USB CDC、无线串口端口接收环形缓冲区大小，必须是2的幂
+#define WIRELESS_PORT_TX_SIZE 256      // 无线串口异步发送队列大小，必须是2的幂，至少放下一个最长的二进制帧
+//---------协议引擎端口 END
+
+//---------电机状态遥测 START
+#define TELEMETRY_FRAME_TAG 30      // 遥测帧标签，不与命令标签冲突
+#define TELEMETRY_USE_CDC_PORT (0)  // 1 遥测帧从USB CDC端口发送(需PROTOCOL_USE_CDC_PORT)，0 从DEBUG_UART(DMA后台发送)发送
+//---------电机状态遥测 END
+//---------运动日志 START
+#define MOTION_LOG_USE_W25Q32 (1) // 1 电机事件写入外部Flash(W25Q32)黑匣子日志，0 不使用
+#define MOTION_LOG_FRAME_TAG 31   // 日志导出帧标签，由命令标签22导出
+//---------运动日志 END
+
 // ******任务函数
 void PeripheraAll_Init();
 void Time_Slice_Offset_Register(void);
 void While_Task(void);
 void UART_packet_TASKhandler(void);
+void Telemetry_Task(void);
+void Counter_Checkpoint_Task(void);
+void Motion_Log_Task(void);
+void Time_Slice_Balance_Task(void);
 void key_Processing(void);
 void Hard_Real_Time_Processing(void);
 // ******任务函数 END
@@ -0,0 +1,238 @@
+/*********************************************************************************************************************
+ * 电机状态二进制遥测，用法见 Telemetry.h
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，电机状态采样队列+抽取+二进制帧打包发送
+ * 2026-10-19     Sxxx      V1.1，样本序号不连续处另起一帧，帧内第i个样本序号恒为SEQ+i
+ ********************************************************************************************************************/
+#include "Telemetry.h"
+
+/**
+ * @brief 绑定步进运动实例，采样 state/timer_ms/step_count/pwm_duty
+ */
+void Telemetry_Bind_Step(Telemetry_Channel_TpDef_struct *channel, const motor_step_instance_t *instance)
+{
+    channel->step = instance;
+    channel->recip = NULL;
+}
+
+/**
+ * @brief 绑定往复运动实例，采样 state/timer_ms/pwm_duty，步数字段填0
+ */
+void Telemetry_Bind_Recip(Telemetry_Channel_TpDef_struct *channel, const motor_recip_instance_t *instance)
+{
+    channel->recip = instance;
+    channel->step = NULL;
+}
+
+/**
+ * @brief 挂载电流、编码器读取函数，没有的传NULL(对应字段填0)
+ * @warning 读取函数在 Telemetry_Sample() 的上下文中调用，在中断中采样时读取函数也要可在中断中调用且足够快
+ */
+void Telemetry_Set_Sensor(Telemetry_Channel_TpDef_struct *channel, int16_t (*get_current)(void), int32_t (*get_encoder)(void))
+{
+    channel->get_current = get_current;
+    channel->get_encoder = get_encoder;
+}
+
+/**
+ * @brief 初始化通道配置并清空样本队列
+ * @param port： 发送端口，如 &UART_DEBUG_port
+ * @param tag： 帧标签，不要与登记的命令标签冲突
+ * @param field_mask： 字段掩码，Telemetry_Field_enum 按位或
+ * @param decimation： 抽取比，每decimation次 Telemetry_Sample() 采一个样本，0关闭
+ * @warning 初始化时(开始采样前)调用
+ */
+void Telemetry_Config(Telemetry_Channel_TpDef_struct *channel, Protocol_Port_TpDef_struct *port, uint8_t tag, uint8_t field_mask, uint16_t decimation)
+{
+    channel->port = port;
+    channel->tag = tag;
+    channel->field_mask = field_mask & TELEMETRY_FIELD_ALL;
+    channel->decimation = decimation;
+    channel->decimation_count = 0;
+    channel->sample_seq = 0;
+    channel->frame_count = 0;
+    Telemetry_sample_queue_init(&channel->queue);
+}
+
+/**
+ * @brief 运行中修改抽取比，0关闭采样(队列中已有的样本仍会发出)
+ */
+void Telemetry_Set_Rate(Telemetry_Channel_TpDef_struct *channel, uint16_t decimation)
+{
+    channel->decimation = decimation;
+}
+
+/**
+ * @brief 运行中修改字段掩码
+ * @note 样本总是采全部字段，掩码只在打包时使用，随时修改都不会打乱帧内容
+ */
+void Telemetry_Set_Fields(Telemetry_Channel_TpDef_struct *channel, uint8_t field_mask)
+{
+    channel->field_mask = field_mask & TELEMETRY_FIELD_ALL;
+}
+
+/**
+ * @brief 按字段掩码计算一个样本打包后的字节数
+ */
+uint8_t Telemetry_Sample_Size(uint8_t field_mask)
+{
+    uint8_t size = 0;
+    if (field_mask & TELEMETRY_FIELD_STATE)
+        size += 1;
+    if (field_mask & TELEMETRY_FIELD_TIMER_MS)
+        size += 2;
+    if (field_mask & TELEMETRY_FIELD_STEP_COUNT)
+        size += 4;
+    if (field_mask & TELEMETRY_FIELD_PWM)
+        size += 2;
+    if (field_mask & TELEMETRY_FIELD_CURRENT)
+        size += 2;
+    if (field_mask & TELEMETRY_FIELD_ENCODER)
+        size += 4;
+    return size;
+}
+
+/**
+ * @brief 采样一次(按抽取比)，只拷贝字段进样本队列
+ * @note 不组帧、不算CRC、不发送，可在定时器中断或控制任务中调用；队列满时丢弃本样本并计数，样本序号照常加1
+ */
+void Telemetry_Sample(Telemetry_Channel_TpDef_struct *channel)
+{
+    uint16_t decimation = channel->decimation;
+    if (0 == decimation)
+    {
+        return;
+    }
+    if (++channel->decimation_count < decimation)
+    {
+        return;
+    }
+    channel->decimation_count = 0;
+
+    uint16_t seq = channel->sample_seq++;
+    Telemetry_Sample_TpDef_struct *sample = Telemetry_sample_queue_write_slot(&channel->queue);
+    if (NULL == sample)
+    {
+        channel->queue.overflow_count++;
+        return;
+    }
+    sample->seq = seq;
+    if (channel->step != NULL)
+    {
+        sample->state = (uint8_t)channel->step->state;
+        sample->timer_ms = channel->step->timer_ms;
+        sample->step_count = channel->step->step_count;
+        sample->pwm = channel->step->pwm_duty;
+    }
+    else if (channel->recip != NULL)
+    {
+        sample->state = (uint8_t)channel->recip->state;
+        sample->timer_ms = channel->recip->timer_ms;
+        sample->step_count = 0;
+        sample->pwm = channel->recip->pwm_duty;
+    }
+    else
+    {
+        sample->state = 0;
+        sample->timer_ms = 0;
+        sample->step_count = 0;
+        sample->pwm = 0;
+    }
+    sample->current = (channel->get_current != NULL) ? channel->get_current() : 0;
+    sample->encoder = (channel->get_encoder != NULL) ? channel->get_encoder() : 0;
+    Telemetry_sample_queue_write_commit(&channel->queue);
+}
+
+// 小端写入，返回写入后的位置
+static uint8_t *Telemetry_Put_U16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    return p + 2;
+}
+
+static uint8_t *Telemetry_Put_U32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+    return p + 4;
+}
+
+/**
+ * @brief 把队列中的样本按字段掩码打包成帧并从端口发送，每帧尽量装满 BINFRAME_PAYLOAD_MAX
+ * @note  遇到序号不连续(队列溢出丢样)时提前结束本帧，上位机按 SEQ+i 还原每个样本的序号
+ * @return 本次发送的帧数
+ * @warning 在主循环(任务)中调用，与端口的其他发送同一优先级
+ */
+uint8_t Telemetry_Flush(Telemetry_Channel_TpDef_struct *channel)
+{
+    uint8_t payload[BINFRAME_PAYLOAD_MAX];
+    uint8_t frames = 0;
+    uint8_t mask = channel->field_mask;
+    uint8_t sample_size = Telemetry_Sample_Size(mask);
+    uint8_t per_frame = (sample_size == 0) ? 0 : (BINFRAME_PAYLOAD_MAX - TELEMETRY_HEADER_SIZE) / sample_size;
+
+    ring_buffer_size_t pending = Telemetry_sample_queue_num_items(&channel->queue); // 只发调用时已有的样本，采样快于发送时不会一直停在这里
+
+    if (0 == per_frame || NULL == channel->port)
+    {
+        while (pending--)
+        {
+            Telemetry_sample_queue_read_advance(&channel->queue); // 没有可发送的字段，直接丢弃
+        }
+        return 0;
+    }
+
+    while (pending > 0)
+    {
+        uint8_t *p = payload + TELEMETRY_HEADER_SIZE;
+        uint8_t count = 0;
+        uint16_t first_seq = 0;
+        while (count < per_frame && pending > 0)
+        {
+            const Telemetry_Sample_TpDef_struct *sample = Telemetry_sample_queue_read_slot(&channel->queue);
+            if (0 == count)
+            {
+                first_seq = sample->seq;
+                Telemetry_Put_U16(payload + 2, first_seq);
+            }
+            else if (sample->seq != (uint16_t)(first_seq + count))
+            {
+                break; // 中间有丢弃的样本，另起一帧，保证帧内序号连续
+            }
+            if (mask & TELEMETRY_FIELD_STATE)
+                *p++ = sample->state;
+            if (mask & TELEMETRY_FIELD_TIMER_MS)
+                p = Telemetry_Put_U16(p, sample->timer_ms);
+            if (mask & TELEMETRY_FIELD_STEP_COUNT)
+                p = Telemetry_Put_U32(p, (uint32_t)sample->step_count);
+            if (mask & TELEMETRY_FIELD_PWM)
+                p = Telemetry_Put_U16(p, sample->pwm);
+            if (mask & TELEMETRY_FIELD_CURRENT)
+                p = Telemetry_Put_U16(p, (uint16_t)sample->current);
+            if (mask & TELEMETRY_FIELD_ENCODER)
+                p = Telemetry_Put_U32(p, (uint32_t)sample->encoder);
+            Telemetry_sample_queue_read_advance(&channel->queue);
+            count++;
+            pending--;
+        }
+        payload[0] = mask;
+        payload[1] = count;
+        Protocol_Port_Send_Frame(channel->port, channel->tag, BINFRAME_TYPE_RAW, payload, (uint8_t)(p - payload));
+        channel->frame_count++;
+        frames++;
+    }
+    return frames;
+}
+
+/**
+ * @brief 样本队列满而丢弃的样本数
+ */
+uint32_t Telemetry_Dropped_Count(const Telemetry_Channel_TpDef_struct *channel)
+{
+    return channel->queue.overflow_count;
+}
@@ -0,0 +1,95 @@
+/*********************************************************************************************************************
+ * 本模块为电机状态二进制遥测，借助协议引擎端口(Protocol_Engine.h)发送，DEBUG_UART端口为DMA后台发送，也可绑定USB CDC等端口
+ * 简介：按设定的抽取比对电机状态采样(状态、计时、步数、PWM，以及可选的电流、编码器)，多个样本打包成一个二进制帧发送，
+ *       替代 printf_USART_DEBUG 文本观察，可达kHz级采样
+ * 实现：
+ *    Telemetry_Sample() 只把各字段拷贝进通道的样本队列(SPSC，不组帧、不算CRC)，可在定时器中断或高频任务中调用，不影响控制时序；
+ *    Telemetry_Flush() 在主循环中按字段掩码把样本紧凑打包，凑满一帧(或队列取空)后经端口发送。
+ * 帧格式(RAW载荷，小端)：
+ *    | MASK | COUNT | SEQ[2] | 样本1 | 样本2 | ... |
+ *    MASK  字段掩码(见 Telemetry_Field_enum)，每个样本按位序依次只含掩码中的字段
+ *    COUNT 本帧样本数
+ *    SEQ   本帧第一个样本的序号(每采一个样本加1)，帧内第i个样本序号为SEQ+i；丢样处另起一帧，相邻帧序号不连续表示样本队列溢出丢样
+ *    字段长度：STATE 1，TIMER_MS 2，STEP_COUNT 4，PWM 2，CURRENT 2，ENCODER 4
+ * 用法：
+ * *.每个电机一个 Telemetry_Channel_TpDef_struct，Telemetry_Bind_Step()/Telemetry_Bind_Recip() 绑定电机实例，
+ *   有电流、编码器时 Telemetry_Set_Sensor() 挂载读取函数
+ * *.Telemetry_Config() 设置帧标签、字段掩码、抽取比(每N次调用采一个样本，0关闭)和发送端口，初始化时调用；
+ *   运行中用 Telemetry_Set_Rate()/Telemetry_Set_Fields() 修改(如挂在命令标签上由上位机设置)
+ * *.采样周期处调用 Telemetry_Sample()，主循环周期调用 Telemetry_Flush()，两次Flush之间的样本数不要超过 TELEMETRY_QUEUE_SIZE-1
+ * 注意：
+ * *.同一通道只能有一个采样者和一个发送者
+ * *.发送端口的带宽要大于 样本字节数*采样率，否则DMA发送环形缓冲区放不下的字节被丢弃，上位机按CRC丢弃残帧，由SEQ不连续发现丢样
+ * 修改记录
+ *
+ * 日期            作者                             备注
+ * 2026-10-19     Sxxx      V1.0，电机状态采样队列+抽取+二进制帧打包发送
+ * 2026-10-19     Sxxx      V1.1，样本序号不连续处另起一帧，帧内第i个样本序号恒为SEQ+i
+ ********************************************************************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "stdint.h"
+#include <stdbool.h>
+#include "Ring_Buffer.h"
+#include "Protocol_Engine.h"
+#include "DC_Motion.h"
+
+#define TELEMETRY_QUEUE_SIZE 32   // 每个通道的样本队列大小，必须是2的幂
+#define TELEMETRY_HEADER_SIZE 4   // MASK COUNT SEQ[2]
+
+// 遥测字段
+typedef enum
+{
+    TELEMETRY_FIELD_STATE = 0x01,      // 状态机状态，1字节
+    TELEMETRY_FIELD_TIMER_MS = 0x02,   // 状态计时(ms)，2字节
+    TELEMETRY_FIELD_STEP_COUNT = 0x04, // 步数计数，4字节，往复运动实例为0
+    TELEMETRY_FIELD_PWM = 0x08,        // PWM占空比，2字节
+    TELEMETRY_FIELD_CURRENT = 0x10,    // 电流，2字节，需挂载读取函数
+    TELEMETRY_FIELD_ENCODER = 0x20,    // 编码器计数，4字节，需挂载读取函数
+    TELEMETRY_FIELD_ALL = 0x3F,
+} Telemetry_Field_enum;
+
+// 一个样本，私有
+typedef struct
+{
+    uint16_t seq;
+    uint8_t state;
+    uint16_t timer_ms;
+    int32_t step_count;
+    uint16_t pwm;
+    int16_t current;
+    int32_t encoder;
+} Telemetry_Sample_TpDef_struct;
+
+RING_DEFINE(Telemetry_sample_queue, Telemetry_Sample_TpDef_struct, TELEMETRY_QUEUE_SIZE)
+
+// 遥测通道，每个电机一个
+typedef struct
+{
+    const volatile motor_step_instance_t *step;   // 绑定的步进运动实例，私有
+    const volatile motor_recip_instance_t *recip; // 绑定的往复运动实例，私有
+    int16_t (*get_current)(void);               // 电流读取函数，可为NULL
+    int32_t (*get_encoder)(void);               // 编码器读取函数，可为NULL
+    Protocol_Port_TpDef_struct *port;           // 发送端口
+    uint8_t tag;                                // 帧标签
+    volatile uint8_t field_mask;                // 字段掩码 Telemetry_Field_enum
+    volatile uint16_t decimation;               // 抽取比，每decimation次Telemetry_Sample()采一个样本，0关闭
+    uint16_t decimation_count;                  // 抽取计数，私有
+    uint16_t sample_seq;                        // 下一个样本的序号，溢出丢弃的样本也占序号，私有
+    Telemetry_sample_queue_t queue;             // 样本队列，私有
+    uint32_t frame_count;                       // 已发送帧数
+} Telemetry_Channel_TpDef_struct;
+
+void Telemetry_Bind_Step(Telemetry_Channel_TpDef_struct *channel, const motor_step_instance_t *instance);
+void Telemetry_Bind_Recip(Telemetry_Channel_TpDef_struct *channel, const motor_recip_instance_t *instance);
+void Telemetry_Set_Sensor(Telemetry_Channel_TpDef_struct *channel, int16_t (*get_current)(void), int32_t (*get_encoder)(void));
+void Telemetry_Config(Telemetry_Channel_TpDef_struct *channel, Protocol_Port_TpDef_struct *port, uint8_t tag, uint8_t field_mask, uint16_t decimation);
+void Telemetry_Set_Rate(Telemetry_Channel_TpDef_struct *channel, uint16_t decimation);
+void Telemetry_Set_Fields(Telemetry_Channel_TpDef_struct *channel, uint8_t field_mask);
+void Telemetry_Sample(Telemetry_Channel_TpDef_struct *channel);
+uint8_t Telemetry_Flush(Telemetry_Channel_TpDef_struct *channel);
+uint8_t Telemetry_Sample_Size(uint8_t field_mask);
+uint32_t Telemetry_Dropped_Count(const Telemetry_Channel_TpDef_struct *channel);
+
+#endif // TELEMETRY_H
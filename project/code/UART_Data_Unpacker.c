@@ -60,17 +60,75 @@ int main(void)
  * 2024-03-31     Sxxx      V1.1ӻλתݣٴжϿ
  * 2024-04-14     Sxxx      V1.2ڵ߼ʹдڡDEBUG_UARTá
  * 2024-04-21     Sxxx      V1.3DebugPrintڵԣŻע
+ * 2026-10-19     Sxxx      V1.4ڽոûλSPSCģʽжֻдͷѭֻдβʱֽڲ
+ * 2026-10-19     Sxxx      V1.5λΪ㿽ȡβθ
+ * 2026-10-19     Sxxx      V1.6DMAѭģʽDMAֱд뻷λжϷͷ
+ * 2026-10-19     Sxxx      V1.7printf_USART_DEBUGΪд뷢ͻλDMĄͣٵȴʱ
+ * 2026-10-19     Sxxx      V1.8֡ʽ(ǰ׺+ӲCRC32غ)PacketFrame_Analysisд
+ * 2026-10-19     Sxxx      V1.9ǩұıǩɢСƱǩֱʱֶַֽ֧ڱǩ
+ * 2026-10-19     Sxxx      V1.10֧һǩ/ֵд룬ֻһӦ
+ * 2026-10-19     Sxxx      V1.11ݰУ봦ɻݰ
+ * 2026-10-19     Sxxx      V1.12ַ֡֡Э棬DEBUG_UARTΪһ˿ڣǩ˿ڹ
+ * 2026-10-19     Sxxx      V1.13ıֵprintf_USART_DEBUGFast_Numberʵ֣ȥatof/atoi/vsnprintf
+ * 2026-10-19     Sxxx      V1.14ִ֧֡ŵִ֡кACK/NACKӦ֡
+ * 2026-10-19     Sxxx      V1.15DMAշͨzf_driver_dma롢òַжϣͨռʱ˻жϽա
+ * 2026-10-19     Sxxx      V1.16ı֡֡ͬʱգ֡ͷ֣UART_DEBUG_got_is_frame ָʾǰʽ
+ * 2026-10-19     Sxxx      V1.17ıֵȫϷд룬Ӧʵдһ
+ * 2026-10-19     Sxxx      V1.18 UART_DEBUG_Tx_Free ѯͻλʣռ䣬صЭ˿ڹ
+ * 2026-10-19     Sxxx      V1.19ıǩֵͼֵǩСֵָΪд
  ********************************************************************************************************************/
 #include "UART_Data_Unpacker.h"
 
 // 
 uint8_t UART_DEBUG_got_data[PACKET_MAX_SIZE] = {0}; // ڽյ
 volatile bool UART_DEBUG_data_packet_ready = false; // ڽݰı־λɽ1
+BinFrame_TpDef_struct UART_DEBUG_got_frame;          // յĶ֡
+bool UART_DEBUG_got_is_frame = false;                // ǰʽ1 ֡0 ı
+Protocol_Port_TpDef_struct UART_DEBUG_port;          // Э˿ڣ֡Ľַ֡Ӧ𶼾˶˿
+
+#if UART_DEBUG_USE_TEXT_FRAME
+// ıݰУ봦˽(֡İ UART_DEBUG_port )
+typedef struct
+{
+    uint8_t data[PACKET_MAX_SIZE];
+} UART_DEBUG_Packet_TpDef_struct;
+RING_DEFINE(UART_DEBUG_packet_queue, UART_DEBUG_Packet_TpDef_struct, UART_DEBUG_PACKET_QUEUE_SIZE)
+static UART_DEBUG_packet_queue_t UART_DEBUG_packet_queue;
+
+// һʽİʱֹͣȡֽڣڻλ
+static inline bool UART_DEBUG_Queue_Full(void)
+{
+#if UART_DEBUG_USE_BINARY_FRAME
+    if (Protocol_packet_queue_is_full(&UART_DEBUG_port.queue))
+    {
+        return true;
+    }
+#endif
+    return UART_DEBUG_packet_queue_is_full(&UART_DEBUG_packet_queue);
+}
+#endif
+
+// ıǩұ˽(֡ǩЭУж˿ڹ)
+static const PacketTag_TpDef_struct *PacketTag_hash_table[PACKET_TAG_HASH_SIZE] = {NULL}; // ıǩɢб(Ѱַ)
 
 // λ˽
 ring_buffer_t ringbuffer_UART_DEBUG;
 uint8_t ringbuffer_place_UART_DEBUG[RINGBUFFER_SIZE] = {0};
 
+#if UART_DEBUG_TX_USE_DMA
+// ͻλprintfΪߣDMAжΪߣ˽
+static ring_buffer_t ringbuffer_UART_DEBUG_TX;
+static uint8_t ringbuffer_place_UART_DEBUG_TX[UART_DEBUG_TX_RINGBUFFER_SIZE] = {0};
+static volatile ring_buffer_size_t UART_DEBUG_tx_dma_len = 0; // DMAڷ͵ֽ0ʾDMA
+static bool UART_DEBUG_tx_dma_ready = false;                  // 뵽DMAͨ
+#endif
+
+#if UART_DEBUG_RX_USE_DMA
+static bool UART_DEBUG_Rx_DMA_Init(void);
+#endif
+#if UART_DEBUG_TX_USE_DMA
+static void UART_DEBUG_Tx_DMA_Init(void);
+#endif
 
 /*
 * @brief ڳʼ
@@ -78,11 +136,200 @@ uint8_t ringbuffer_place_UART_DEBUG[RINGBUFFER_SIZE] = {0};
 void UART_DEBUG_Init(void)
 {
     uart_init(DEBUG_UART_INDEX, DEBUG_UART_BAUDRATE, DEBUG_UART_TX_PIN, DEBUG_UART_RX_PIN); // ڳʼ
+#if UART_DEBUG_RX_USE_DMA
+    ring_buffer_init(&ringbuffer_UART_DEBUG, ringbuffer_place_UART_DEBUG, RINGBUFFER_SIZE); // ȳʼλDMAֱд洢
+    if (!UART_DEBUG_Rx_DMA_Init())                                                          // DMAѭ+ж V1.6
+    {
+        uart_rx_interrupt(DEBUG_UART_INDEX, ENABLE); // DMAͨռã˻ÿֽڽж V1.15
+        interrupt_set_priority(UART8_IRQn, (0 << 5) | 1);
+    }
+#else
     uart_rx_interrupt(DEBUG_UART_INDEX, ENABLE);                                            // ж
     interrupt_set_priority(UART8_IRQn, (0 << 5) || 1);                                     // usart3жȼ
     ring_buffer_init(&ringbuffer_UART_DEBUG, ringbuffer_place_UART_DEBUG, RINGBUFFER_SIZE); // λʼ V1.1
+#endif
+#if UART_DEBUG_TX_USE_DMA
+    UART_DEBUG_Tx_DMA_Init(); // DMĄ V1.7
+#endif
+    BinFrame_Init(); // CRC V1.8
+    Protocol_Port_Init(&UART_DEBUG_port, "UART_DEBUG", &ringbuffer_UART_DEBUG, NULL, RINGBUFFER_SIZE, UART_DEBUG_Write_Buffer); // ջʼ V1.12
+    Protocol_Port_Set_Tx_Free(&UART_DEBUG_port, UART_DEBUG_Tx_Free); // ǰȷ֡ŵ V1.18
+#if UART_DEBUG_USE_TEXT_FRAME
+    UART_DEBUG_packet_queue_init(&UART_DEBUG_packet_queue); // ݰ V1.11
+#endif
+}
+
+#if UART_DEBUG_RX_USE_DMA
+/*
+ * @brief DMAհ/ȫصDMAͨж dma_irq_handler() 
+ */
+static void UART_DEBUG_Rx_DMA_Callback(dma_channel_enum dma_ch, uint8 event, void *arg)
+{
+    USART_DEBUG_DMA_IRQ_Function();
+}
+
+/*
+ * @brief DMAѭճʼ
+ * @note  DMAԻλ洢ΪĿѭд룬ÿֽڲٽжϣ
+ *        ߿(IDLE)жԼDMA/ȫж USART_DEBUG_DMA_IRQ_Function() µͷ
+ *        жƵÿֽһνΪÿһΡ
+ * @return DMAͨռ÷false
+ */
+static bool UART_DEBUG_Rx_DMA_Init(void)
+{
+    if (dma_channel_request(UART_DEBUG_RX_DMA_CHANNEL, "UART_DEBUG RX"))
+    {
+        return false;
+    }
+    dma_init(UART_DEBUG_RX_DMA_CHANNEL, DMA_PERIPH_TO_MEMORY, (uint32_t)&UART_DEBUG_USART->DATAR, ringbuffer_place_UART_DEBUG, RINGBUFFER_SIZE,
+             DMA_WIDTH_8BIT, DMA_MODE_CIRCULAR, DMA_PRIORITY_HIGH);
+    dma_set_callback(UART_DEBUG_RX_DMA_CHANNEL, DMA_EVENT_HALF | DMA_EVENT_COMPLETE, UART_DEBUG_Rx_DMA_Callback, NULL); // ûпмʱ/ȫҲһͷ
+    interrupt_set_priority(UART_DEBUG_RX_DMA_IRQN, (0 << 5) | 1);
+    dma_start(UART_DEBUG_RX_DMA_CHANNEL);
+
+    USART_DMACmd(UART_DEBUG_USART, USART_DMAReq_Rx, ENABLE);
+    USART_ITConfig(UART_DEBUG_USART, USART_IT_IDLE, ENABLE); // ֻжϣж
+    interrupt_set_priority(UART8_IRQn, (0 << 5) | 1);
+    interrupt_enable(UART8_IRQn);
+    return true;
 }
 
+/**
+ *  @brief DMAģʽ·λͷ
+ *  @note DMAʣDMAдָΪµͷDMA֪β
+ *        µֽڳʣռʱ˵δѱǣֵ overflow_count
+ *  @warning isr.cĴڿжеã־λɵôDMAͨжо UART_DEBUG_Rx_DMA_Callback 
+ */
+void USART_DEBUG_DMA_IRQ_Function(void)
+{
+    ring_buffer_size_t head = ringbuffer_UART_DEBUG.head_index;
+    ring_buffer_size_t dma_head = (RINGBUFFER_SIZE - dma_get_remaining(UART_DEBUG_RX_DMA_CHANNEL)) & (RINGBUFFER_SIZE - 1);
+    ring_buffer_size_t received = (dma_head - head) & (RINGBUFFER_SIZE - 1);
+    ring_buffer_size_t free_space = (ringbuffer_UART_DEBUG.tail_index - head - 1) & (RINGBUFFER_SIZE - 1);
+
+    if (received > free_space)
+    {
+        ringbuffer_UART_DEBUG.overflow_count += received - free_space; // δѱDMA
+    }
+    RING_BUFFER_FENCE_RELEASE(); // DMAдͷɼ
+    ringbuffer_UART_DEBUG.head_index = dma_head;
+}
+#endif
+
+#if UART_DEBUG_TX_USE_DMA
+/*
+ * @brief DMAɻصDMAͨж dma_irq_handler() 
+ */
+static void UART_DEBUG_Tx_DMA_Callback(dma_channel_enum dma_ch, uint8 event, void *arg)
+{
+    USART_DEBUG_TX_DMA_IRQ_Function();
+}
+
+/*
+ * @brief DMAͳʼ
+ * @note  DMAÿηͷͻλһ(㿽)жͷݲһ
+ */
+static void UART_DEBUG_Tx_DMA_Init(void)
+{
+    ring_buffer_init(&ringbuffer_UART_DEBUG_TX, ringbuffer_place_UART_DEBUG_TX, UART_DEBUG_TX_RINGBUFFER_SIZE);
+    UART_DEBUG_tx_dma_len = 0;
+    UART_DEBUG_tx_dma_ready = false;
+
+    if (dma_channel_request(UART_DEBUG_TX_DMA_CHANNEL, "UART_DEBUG TX"))
+    {
+        return; // ͨռãUART_DEBUG_Write_Buffer 
+    }
+    dma_init(UART_DEBUG_TX_DMA_CHANNEL, DMA_MEMORY_TO_PERIPH, (uint32_t)&UART_DEBUG_USART->DATAR, ringbuffer_place_UART_DEBUG_TX, 0,
+             DMA_WIDTH_8BIT, DMA_MODE_NORMAL, DMA_PRIORITY_MEDIUM);
+    dma_set_callback(UART_DEBUG_TX_DMA_CHANNEL, DMA_EVENT_COMPLETE, UART_DEBUG_Tx_DMA_Callback, NULL);
+    interrupt_set_priority(UART_DEBUG_TX_DMA_IRQN, (0 << 5) | 2); // Ͳȼڽ
+    USART_DMACmd(UART_DEBUG_USART, USART_DMAReq_Tx, ENABLE);
+    UART_DEBUG_tx_dma_ready = true;
+}
+
+/*
+ * @brief DMAʱһη
+ * @note  ֻDMAжУرDMAжϺ
+ */
+static void UART_DEBUG_Tx_DMA_Start(void)
+{
+    char *span = NULL;
+    ring_buffer_size_t len = 0;
+
+    if (UART_DEBUG_tx_dma_len) // DMAڷͣжϻŷ
+    {
+        return;
+    }
+    len = ring_buffer_read_span(&ringbuffer_UART_DEBUG_TX, &span);
+    if (0 == len)
+    {
+        return;
+    }
+    UART_DEBUG_tx_dma_len = len;
+    dma_restart(UART_DEBUG_TX_DMA_CHANNEL, span, (uint16_t)len);
+}
+
+/**
+ *  @brief DMAɴͷѷ͵ݲһ
+ *  @warning DMAͨжϾ UART_DEBUG_Tx_DMA_Callback 
+ */
+void USART_DEBUG_TX_DMA_IRQ_Function(void)
+{
+    ring_buffer_read_advance(&ringbuffer_UART_DEBUG_TX, UART_DEBUG_tx_dma_len);
+    UART_DEBUG_tx_dma_len = 0;
+    UART_DEBUG_Tx_DMA_Start();
+}
+
+/**
+ *  @brief ȡͻλŲ¶ֽ
+ */
+ring_buffer_size_t UART_DEBUG_Tx_Dropped_Count(void)
+{
+    return ringbuffer_UART_DEBUG_TX.overflow_count;
+}
+
+/**
+ *  @brief ȡͻλܷµֽ
+ *  @note  DMAͨռ()ʱܷ£0xFFFF
+ */
+uint16_t UART_DEBUG_Tx_Free(void)
+{
+    if (!UART_DEBUG_tx_dma_ready)
+    {
+        return 0xFFFF;
+    }
+    return (uint16_t)(UART_DEBUG_TX_RINGBUFFER_SIZE - 1 - ring_buffer_num_items(&ringbuffer_UART_DEBUG_TX));
+}
+
+/**
+ *  @brief ȴͻλеȫ()
+ *  @note  λ͹ǰãƽʱҪ
+ */
+void UART_DEBUG_Tx_Flush(void)
+{
+    while (!ring_buffer_is_empty(&ringbuffer_UART_DEBUG_TX))
+    {
+    }
+    while (USART_GetFlagStatus(UART_DEBUG_USART, USART_FLAG_TC) == RESET) // ȴһֽƳ
+    {
+    }
+}
+#else
+ring_buffer_size_t UART_DEBUG_Tx_Dropped_Count(void)
+{
+    return 0;
+}
+
+uint16_t UART_DEBUG_Tx_Free(void)
+{
+    return 0xFFFF; // ܷͣ
+}
+
+void UART_DEBUG_Tx_Flush(void)
+{
+}
+#endif
+
 /**
  * @brief Իǩƥʹá
  * @param Tag_packet[] ṹ飬ڴұűǩӺ
@@ -111,6 +358,280 @@ void PacketTag_Analysis(PacketTag_TpDef_struct Tag_packet[], uint8_t tag_count)
     // U1_printf("The \"%s\" is not find.", Tag_packet[i].tag);
 }
 
+/*
+ * @brief ǩɢֵ(FNV-1a)
+ */
+static uint32_t PacketTag_Hash(const char *tag, uint8_t len)
+{
+    uint32_t hash = 2166136261UL;
+    for (uint8_t i = 0; i < len; i++)
+    {
+        hash ^= (uint8_t)tag[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+/*
+ * @brief ɢбвұǩ
+ * @return ҵر򷵻NULL
+ */
+static const PacketTag_TpDef_struct *PacketTag_Find(const char *tag, uint8_t len)
+{
+    uint32_t slot = PacketTag_Hash(tag, len) & (PACKET_TAG_HASH_SIZE - 1);
+    for (uint16_t probe = 0; probe < PACKET_TAG_HASH_SIZE; probe++)
+    {
+        const PacketTag_TpDef_struct *entry = PacketTag_hash_table[slot];
+        if (NULL == entry)
+        {
+            return NULL; // ղۣǩ
+        }
+        if (strncmp(entry->tag, tag, len) == 0 && entry->tag[len] == '\0')
+        {
+            return entry;
+        }
+        slot = (slot + 1) & (PACKET_TAG_HASH_SIZE - 1); // ̽
+    }
+    return NULL;
+}
+
+/**
+ * @brief ıǩɢбʼʱһ
+ * @param Tag_packet[] ṹ飬һֱЧ(ȫֻ̬)
+ * @param tag_count ұ
+ * @return ȫǼǳɹtrueǩΪաظɢбʱfalse
+ * @note  ٴεû׷ӵǼǣǩ1~TAG_MAX_LENGTH
+ */
+bool PacketTag_Register(const PacketTag_TpDef_struct Tag_packet[], uint16_t tag_count)
+{
+    bool ok = true;
+    for (uint16_t i = 0; i < tag_count; i++)
+    {
+        uint8_t len = strnlen(Tag_packet[i].tag, TAG_MAX_LENGTH + 1);
+        if (len < TAG_LENGTH || len > TAG_MAX_LENGTH || PacketTag_Find(Tag_packet[i].tag, len) != NULL)
+        {
+            ok = false;
+            continue;
+        }
+        uint32_t slot = PacketTag_Hash(Tag_packet[i].tag, len) & (PACKET_TAG_HASH_SIZE - 1);
+        uint16_t probe = 0;
+        while (PacketTag_hash_table[slot] != NULL && probe++ < PACKET_TAG_HASH_SIZE)
+        {
+            slot = (slot + 1) & (PACKET_TAG_HASH_SIZE - 1);
+        }
+        if (PacketTag_hash_table[slot] != NULL)
+        {
+            ok = false; // ɢб
+            continue;
+        }
+        PacketTag_hash_table[slot] = &Tag_packet[i];
+    }
+    return ok;
+}
+
+/*
+ * @brief ıĿȡǩ
+ * @param value ֵʼλ
+ * @return ҵرϢNULL
+ * @note   TAG_DELIMITER ʱָǰΪǩ(ֽڱǩ)ȡǰTAG_LENGTHַΪǩ
+ */
+static const PacketTag_TpDef_struct *PacketTag_Resolve(const char *packet, const char **value)
+{
+    const char *delimiter = memchr(packet, TAG_DELIMITER, strnlen(packet, TAG_MAX_LENGTH + 1)); // ֻڱǩ󳤶ҷָ
+    uint8_t tag_len = TAG_LENGTH;
+    uint8_t value_pos = TAG_LENGTH;
+
+    if (delimiter != NULL && (delimiter - packet) >= TAG_LENGTH)
+    {
+        tag_len = delimiter - packet;
+        value_pos = tag_len + 1;
+    }
+    const PacketTag_TpDef_struct *entry = PacketTag_Find(packet, tag_len);
+    if (NULL == entry)
+    {
+        printf_USART_DEBUG("The \"%.*s\" is not find.", tag_len, packet); // 
+        return NULL;
+    }
+    *value = packet + value_pos;
+    return entry;
+}
+
+/*
+ * @brief ǩֵͼֵıǷ(źͽβհ)
+ * @note  ǩ(UnpackData_Handle_Int_FireWater)ֻʮ"1.5""1e3"Ϊ
+ *        ǩ飬Сָ
+ */
+static bool PacketTag_Value_Valid(const PacketTag_TpDef_struct *entry, const char *value)
+{
+    const char *end = NULL;
+    bool has_digit = false;
+
+    if (UnpackData_Handle_Int_FireWater == entry->function_handler)
+    {
+        FastNum_Parse_Int(value, &end);
+    }
+    else
+    {
+        FastNum_Parse_Float(value, &end);
+    }
+    for (const char *p = value; p < end; p++)
+    {
+        if (*p >= '0' && *p <= '9')
+        {
+            has_digit = true;
+            break;
+        }
+    }
+    return has_digit && end[strspn(end, " \t\r\n")] == '\0';
+}
+
+/**
+ * @brief ɢбַһıݰʱ
+ * @param packet յݰ('\0'β)
+ * @return ҵǩôtrue
+ * @note   TAG_DELIMITER ʱָǰΪǩ(ֽڱǩ)ȡǰTAG_LENGTHַΪǩ
+ *        Ϊݰ packet + TAG_LENGTH ȡֵĴָTAG_LENGTHΪֵʼλ
+ */
+bool PacketTag_Dispatch(const char *packet)
+{
+    const char *value = NULL;
+    const PacketTag_TpDef_struct *entry = PacketTag_Resolve(packet, &value);
+    if (NULL == entry)
+    {
+        return false;
+    }
+    entry->function_handler(value - TAG_LENGTH, entry->value_ptr);
+    return true;
+}
+
+/**
+ * @brief ַһǩ/ֵıݰһӦ
+ * @param packet յݰ('\0'β) TAG_BATCH_SEPARATOR ָ ~}kp=1.5;ki=0.2;kd=0}~ᱻ͵з
+ * @return д
+ * @note  ֵʽȫϷд룻һĿϷʱһҲд롣
+ *        Ӧʽ "ACK д/\r\n"
+ */
+uint8_t PacketTag_Dispatch_Batch(char *packet)
+{
+    const PacketTag_TpDef_struct *entry[TAG_BATCH_MAX_ITEMS];
+    const char *value[TAG_BATCH_MAX_ITEMS];
+    uint8_t total = 0;
+    bool valid = true;
+    char *item = packet;
+
+    // һ飺зֵ֡д
+    while (item != NULL && *item != '\0')
+    {
+        char *next = strchr(item, TAG_BATCH_SEPARATOR);
+        if (next != NULL)
+        {
+            *next++ = '\0';
+        }
+        if (total >= TAG_BATCH_MAX_ITEMS)
+        {
+            printf_USART_DEBUG("Error: too many items.");
+            valid = false;
+            break;
+        }
+        entry[total] = PacketTag_Resolve(item, &value[total]);
+        if (NULL == entry[total])
+        {
+            valid = false;
+        }
+        else if (!PacketTag_Value_Valid(entry[total], value[total]))
+        {
+            printf_USART_DEBUG("The \"%s\" value error.", item);
+            valid = false;
+        }
+        total++;
+        item = next;
+    }
+    if (!valid)
+    {
+        printf_USART_DEBUG("ACK 0/%u\r\n", total);
+        return 0;
+    }
+
+    // ڶ飺д
+    for (uint8_t i = 0; i < total; i++)
+    {
+        entry[i]->function_handler(value[i] - TAG_LENGTH, entry[i]->value_ptr);
+    }
+    printf_USART_DEBUG("ACK %u/%u\r\n", total, total);
+    return total;
+}
+
+/**
+ * @brief ֡ǩֱʼʱһ
+ * @param Frame_packet[] ṹ飬һֱЧ(ȫֻ̬)
+ * @param tag_count ұ
+ * @return ȫǼǳɹtrueǩظʱȵǼǵĲfalse
+ * @note  ǩЭУж˿(ԴڡUSB CDCߴڵ)
+ */
+bool PacketFrame_Register(const PacketFrame_TpDef_struct Frame_packet[], uint16_t tag_count)
+{
+    return Protocol_Register(Frame_packet, tag_count);
+}
+
+/**
+ * @brief ַһ֡У飬ȫϷһд룬DEBUG_UARTһӦ֡
+ * @param frame ֡(typeΪBINFRAME_TYPE_BATCH)
+ * @return ȫд뷵trueһĿʽ󡢱ǩδǼǻͲһʱһҲд룬false
+ * @note  Ӧ֡ʽ Protocol_Dispatch_Batch()
+ */
+bool PacketFrame_Dispatch_Batch(const BinFrame_TpDef_struct *frame)
+{
+    return PROTOCOL_DISPATCH_OK == Protocol_Dispatch_Batch(&UART_DEBUG_port, frame);
+}
+
+/**
+ * @brief ǩֱַһ֡ʱ
+ * @param frame յ֡֡(BINFRAME_TYPE_REQUEST)ִкACK/NACKӦ֡
+ * @return дɹtrueǩδǼǡͲһ»ܾfalse
+ */
+bool PacketFrame_Dispatch(const BinFrame_TpDef_struct *frame)
+{
+    int8_t result = Protocol_Dispatch(&UART_DEBUG_port, frame);
+    if (BINFRAME_TYPE_REQUEST == frame->type)
+    {
+        return PROTOCOL_DISPATCH_OK == result; // ֡ĽӦ֡лظ
+    }
+    if (PROTOCOL_DISPATCH_UNKNOWN_TAG == result)
+    {
+        printf_USART_DEBUG("The tag %u is not find.", frame->tag);
+    }
+    else if (PROTOCOL_DISPATCH_TYPE_ERROR == result)
+    {
+        printf_USART_DEBUG("The tag %u type %u mismatch.", frame->tag, frame->type);
+    }
+    return PROTOCOL_DISPATCH_OK == result;
+}
+
+/**
+ * @brief Զ֡ǩһʱغдر
+ * @param frame յ֡
+ * @param Frame_packet[] ṹ飬űǩغ
+ * @param tag_count ұ
+ * @return дɹtrueǩڻͲһ·false
+ */
+bool PacketFrame_Analysis(const BinFrame_TpDef_struct *frame, const PacketFrame_TpDef_struct Frame_packet[], uint8_t tag_count)
+{
+    for (uint8_t i = 0; i < tag_count; i++)
+    {
+        if (Frame_packet[i].tag == frame->tag)
+        {
+            if (BinFrame_Get_Value(frame, Frame_packet[i].type, Frame_packet[i].value_ptr))
+            {
+                return true;
+            }
+            printf_USART_DEBUG("The tag %u type %u mismatch.", frame->tag, frame->type);
+            return false;
+        }
+    }
+    printf_USART_DEBUG("The tag %u is not find.", frame->tag);
+    return false;
+}
+
 /**
  *  @brief ʹfire waterʽvofa+
  *  @warning ʹFloatͽ
@@ -119,7 +640,7 @@ void UnpackData_Handle_Float_FireWater(const char *packet, void *value)
 {
     // char numString[PACKET_MAX_SIZE];
     // strncpy(numString, packet + TAG_LENGTH, PACKET_MAX_SIZE - 1);
-    *((float *)value) = atof(packet + TAG_LENGTH);
+    *((float *)value) = FastNum_Parse_Float(packet + TAG_LENGTH, NULL); // ţnewlibatof
 }
 /**
  *  @brief ʹfire waterʽvofa+
@@ -129,7 +650,7 @@ void UnpackData_Handle_Int_FireWater(const char *packet, void *value)
 {
     // char numString[PACKET_MAX_SIZE];
     // strncpy(numString, packet + TAG_LENGTH, PACKET_MAX_SIZE - 1);
-    *((int *)value) = atoi(packet + TAG_LENGTH);
+    *((int *)value) = FastNum_Parse_Int(packet + TAG_LENGTH, NULL);
 }
 /**
  *  @brief ieee754ʽȡint16ݣűǩǸ߰λһλǵͰλ
@@ -149,17 +670,64 @@ void UnpackData_Handle_Int16_IEEE754(const uint8 *packet, void *int16_value)
  *  @brief ʹDEBUG_UARTprintf
  *  @param ʽַ
  *  @return void
- *  @warning
+ *  @warning DMAģʽֻѭ()еãжеã63ֽ
  *  @note ӣ printf_USART_DEBUG("text:%d", 1212); ڽյ text:1212
+ *  @note DMAģʽֻʽ뷢ͻλأʱ(UART_DEBUG_Tx_Dropped_Count)
+ *  @note ʽʹ FastNum_Vsnprintf()ֻ֧ %d %i %u %x %X %c %s %f %% ȡȣ Fast_Number.h
  */
 void printf_USART_DEBUG(char *format_str, ...)
 {
-    uint8_t buffer[64];
+    char buffer[64];
     va_list arg;
     va_start(arg, format_str);
-    vsprintf(buffer, format_str, arg);
+    uint16_t len = FastNum_Vsnprintf(buffer, sizeof(buffer), format_str, arg);
     va_end(arg);
-    uart_write_string(DEBUG_UART_INDEX, buffer);
+    if (0 == len)
+    {
+        return;
+    }
+    if (len >= sizeof(buffer))
+    {
+#if UART_DEBUG_TX_USE_DMA
+        ringbuffer_UART_DEBUG_TX.overflow_count += len - (sizeof(buffer) - 1); // ʽĲּ붪
+#endif
+        len = sizeof(buffer) - 1;
+    }
+    UART_DEBUG_Write_Buffer((const uint8_t *)buffer, len);
+}
+
+/**
+ *  @brief ʹDEBUG_UARTһ
+ *  @note DMAģʽ·뷢ͻλأŲµֽڶ
+ *  @warning DMAģʽֻѭ()е
+ */
+void UART_DEBUG_Write_Buffer(const uint8_t *data, uint16_t len)
+{
+#if UART_DEBUG_TX_USE_DMA
+    if (!UART_DEBUG_tx_dma_ready)
+    {
+        uart_write_buffer(DEBUG_UART_INDEX, data, len);
+        return;
+    }
+    ring_buffer_queue_arr_spsc(&ringbuffer_UART_DEBUG_TX, (const char *)data, len); // Ųµֽڶȴ
+    interrupt_disable(UART_DEBUG_TX_DMA_IRQN);                                       // 뷢жϻDMA
+    UART_DEBUG_Tx_DMA_Start();
+    interrupt_enable(UART_DEBUG_TX_DMA_IRQN);
+#else
+    uart_write_buffer(DEBUG_UART_INDEX, data, len);
+#endif
+}
+
+/**
+ *  @brief ʹDEBUG_UARTһ֡
+ *  @param tag ǩ
+ *  @param type غ BinFrame_Type_enum
+ *  @param payload غ
+ *  @param len غɳȣֵͱͳ
+ */
+void UART_DEBUG_Send_Frame(uint8_t tag, uint8_t type, const void *payload, uint8_t len)
+{
+    Protocol_Port_Send_Frame(&UART_DEBUG_port, tag, type, payload, len);
 }
 
 /**
@@ -185,7 +753,7 @@ void USART_DEBUG_IRQ_Function(void)
     uint8_t byte = 0;
     if (uart_query_byte(DEBUG_UART_INDEX, &byte))
     {
-        ring_buffer_queue(&ringbuffer_UART_DEBUG, byte); // ֽڷ뻷λ
+        ring_buffer_queue_spsc(&ringbuffer_UART_DEBUG, byte); // ֽڷ뻷λSPSCģʽʱֽڲoverflow_count
                                                          // ڻУѭط
     }
     /*------------------------------жнݰ------------------------------*/
@@ -229,52 +797,107 @@ void USART_DEBUG_IRQ_Function(void)
 
 /**
  *  @brief UART3λеı
- *  @note յһݰԺUART_DEBUG_data_packet_ready 1˳ֱ UART_DEBUG_data_packet_ready 0
+ *  @note ݰȷ(UART_DEBUG_PACKET_QUEUE_SIZE-1)ٵȴӦô
+ *        ǰ(UART_DEBUG_data_packet_ready Ϊ0ʱ)Ӷȡϵһ UART_DEBUG_got_data / UART_DEBUG_got_frame
+ *        ʱֹͣȡֽڣڻλᶪ
  *  @warning UART_DEBUG_data_packet_ready ʹԺһҪ0
  */
 void UART_DEBUG_Ringbuffer_Processer(void)
 {
+#if UART_DEBUG_USE_TEXT_FRAME
+    char *span = NULL;
+    ring_buffer_size_t span_len = 0;
+    ring_buffer_size_t used = 0;
     static uint8_t UART_DEBUG_got_data_index = 0;
     static uint8_t prev_byte = 0;
     static bool start_load_packet_flag = false;
     uint8_t data = 0;
+    uint8_t *packet = NULL;
 
-    while (!ring_buffer_is_empty(&ringbuffer_UART_DEBUG) && !UART_DEBUG_data_packet_ready)
+    // 㿽ֱڻλ洢ֽڽݰֱдвλһδβֻһΣSPSCģʽжϣ
+    // ָʽͬʱʱÿֽͬʱ֡ͷ0xA5ıУı֡ͷ~}Ҳöƽ֡ͬ(CRCУ)
+    while (!UART_DEBUG_Queue_Full() && (span_len = ring_buffer_read_span(&ringbuffer_UART_DEBUG, &span)) != 0)
     {
-        ring_buffer_dequeue(&ringbuffer_UART_DEBUG, &data); // ӻȡһֽ
-
-        if (!start_load_packet_flag)
-        {
-            if (prev_byte == '~' && data == '}')
-            {
-                start_load_packet_flag = true;
-                UART_DEBUG_got_data_index = 0;
-            }
-        }
-        else
+        for (used = 0; used < span_len && !UART_DEBUG_Queue_Full(); used++)
         {
-            if (prev_byte == '}' && data == '~' && start_load_packet_flag)
-            {
-                UART_DEBUG_got_data[UART_DEBUG_got_data_index - 1] = '\0'; // һҪȷUART_DEBUG_got_dataѾҴС㹻
-                UART_DEBUG_data_packet_ready = 1;
-                start_load_packet_flag = false;
-                break;
-            }
-            else if (UART_DEBUG_got_data_index < PACKET_MAX_SIZE)
+            data = (uint8_t)span[used];
+#if UART_DEBUG_USE_BINARY_FRAME
+            Protocol_Port_Parse_Byte(&UART_DEBUG_port, data); // ֡˿ڰ V1.16
+#endif
+            packet = UART_DEBUG_packet_queue_write_slot(&UART_DEBUG_packet_queue)->data; // ύǰλ
+
+            if (!start_load_packet_flag)
             {
-                UART_DEBUG_got_data[UART_DEBUG_got_data_index++] = data;
+                if (prev_byte == '~' && data == '}')
+                {
+                    start_load_packet_flag = true;
+                    UART_DEBUG_got_data_index = 0;
+                }
             }
             else
             {
-                memset(UART_DEBUG_got_data, 0, PACKET_MAX_SIZE);
-                printf_USART_DEBUG("Error: Data packet overflow.\r\n");
-                for (int i = 0; i < PACKET_MAX_SIZE; i++)
+                if (prev_byte == '}' && data == '~' && start_load_packet_flag)
+                {
+                    packet[UART_DEBUG_got_data_index - 1] = '\0'; // ȥβ'}'
+                    UART_DEBUG_packet_queue_write_commit(&UART_DEBUG_packet_queue);
+                    start_load_packet_flag = false;
+                }
+                else if (UART_DEBUG_got_data_index < PACKET_MAX_SIZE)
                 {
-                    printf_USART_DEBUG("0x%02X ", UART_DEBUG_got_data[i]);
+                    packet[UART_DEBUG_got_data_index++] = data;
+                }
+                else
+                {
+                    memset(packet, 0, PACKET_MAX_SIZE);
+                    printf_USART_DEBUG("Error: Data packet overflow.\r\n");
+                    start_load_packet_flag = false;
                 }
-                start_load_packet_flag = false;
             }
+            prev_byte = data;
         }
-        prev_byte = data;
+        ring_buffer_read_advance(&ringbuffer_UART_DEBUG, used); // ͷѽֽ
+    }
+
+#else
+    // ֻն֡Э˿ڽ֡֡˿ڰ
+    Protocol_Port_Parse(&UART_DEBUG_port);
+#endif
+
+    // ǰѴ꣬Ӷȡһ
+#if UART_DEBUG_USE_BINARY_FRAME
+    if (!UART_DEBUG_data_packet_ready && Protocol_Port_Receive(&UART_DEBUG_port, &UART_DEBUG_got_frame))
+    {
+        UART_DEBUG_got_is_frame = true;
+        UART_DEBUG_data_packet_ready = 1;
     }
+#endif
+#if UART_DEBUG_USE_TEXT_FRAME
+    if (!UART_DEBUG_data_packet_ready)
+    {
+        UART_DEBUG_Packet_TpDef_struct *next = UART_DEBUG_packet_queue_read_slot(&UART_DEBUG_packet_queue);
+        if (next != NULL)
+        {
+            memcpy(UART_DEBUG_got_data, next->data, PACKET_MAX_SIZE);
+            UART_DEBUG_packet_queue_read_advance(&UART_DEBUG_packet_queue);
+            UART_DEBUG_got_is_frame = false;
+            UART_DEBUG_data_packet_ready = 1;
+        }
+    }
+#endif
+}
+
+/**
+ *  @brief Ƿδ(λеֽڻеİ)
+ *  @note ΪfalseʱԹȴж
+ */
+bool UART_DEBUG_Packet_Pending(void)
+{
+    bool pending = !ring_buffer_is_empty(&ringbuffer_UART_DEBUG) || UART_DEBUG_data_packet_ready;
+#if UART_DEBUG_USE_BINARY_FRAME
+    pending = pending || Protocol_Port_Pending(&UART_DEBUG_port);
+#endif
+#if UART_DEBUG_USE_TEXT_FRAME
+    pending = pending || !UART_DEBUG_packet_queue_is_empty(&UART_DEBUG_packet_queue);
+#endif
+    return pending;
 }
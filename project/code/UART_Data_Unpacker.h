@@ -10,9 +10,18 @@
  * *.ǩͨ TAG_LENGTH ޸
  * *.λСͨ RINGBUFFER_SIZE ޸ģֻ2ݴη
  * *.PacketTag_TpDef_struct ṹ飬洢ǩغԼر
+ * *.ʼʱ PacketTag_Register()/PacketFrame_Register() ұ֮ PacketTag_Dispatch()/PacketFrame_Dispatch() ʱַ
+ *   ıǩɢбң֧ ǩ=ֵ ʽĶֽڱǩ֡ǩֱ
+ * *.Σı PacketTag_Dispatch_Batch() ~}kp=1.5;ki=0.2}~BINFRAME_TYPE_BATCH֡
+ *   ߶ֻһӦ
+ * *.Ҫȷϵö֡(BINFRAME_TYPE_REQUEST)ÿһACK/NACKӦ֡λɰˮ
  * *.ݾλ棬մ洢 UART_DEBUG_got_data[] Уʹʱֱ
  * *.UART_DEBUG_data_packet_ready ǽϱ־λ1
- * *.ṩ˶ݽʽ
+ * *.ݰȽ(UART_DEBUG_PACKET_QUEUE_SIZE)ǰڼİ棬ᶪʧ
+ * *.ṩ˶ݽʽıֵprintf_USART_DEBUGʽʹ Fast_Number.hnewlibatof/vsnprintf
+ * *.UART_DEBUG_USE_TEXT_FRAME / UART_DEBUG_USE_BINARY_FRAME ѡյĸʽ1ʱͬһ˿ͬʱ ~}}~ ı֡Ͷ֡(ʽBinary_Frame.h)
+ * *.UART_DEBUG_got_is_frame Ϊ1ʱǰǶ֡ UART_DEBUG_got_frame У PacketFrame_Analysis() д룻Ϊ0ʱı UART_DEBUG_got_data 
+ * *.֡Ľַ֡Э(Protocol_Engine.h) UART_DEBUG_port ˿ɣǩ˿(USB CDCߴ)
  * ע⣺
  * *.ʹʱҪUART_DEBUGʼж
  * *.ʹʱҪ ring_buffer_init(&ringbuffer_UART_DEBUG, ringbuffer_place_UART_DEBUG, RINGBUFFER_SIZE); ʼλṹ
@@ -60,6 +69,22 @@ int main(void)
  * 2024-03-31     Sxxx      V1.1ӻλתݣٴжϿ
  * 2024-04-14     Sxxx      V1.2ڵ߼ʹдڡDEBUG_UARTá
  * 2024-04-21     Sxxx      V1.3DebugPrintڵԣŻע
+ * 2026-10-19     Sxxx      V1.4ڽոûλSPSCģʽжֻдͷѭֻдβʱֽڲ
+ * 2026-10-19     Sxxx      V1.5λΪ㿽ȡβθ
+ * 2026-10-19     Sxxx      V1.6DMAѭģʽDMAֱд뻷λжϷͷ
+ * 2026-10-19     Sxxx      V1.7printf_USART_DEBUGΪд뷢ͻλDMĄͣٵȴʱ
+ * 2026-10-19     Sxxx      V1.8֡ʽ(ǰ׺+ӲCRC32غ)PacketFrame_Analysisд
+ * 2026-10-19     Sxxx      V1.9ǩұıǩɢСƱǩֱʱֶַֽ֧ڱǩ
+ * 2026-10-19     Sxxx      V1.10֧һǩ/ֵд룬ֻһӦ
+ * 2026-10-19     Sxxx      V1.11ݰУ봦ɻݰ
+ * 2026-10-19     Sxxx      V1.12ַ֡֡Э棬DEBUG_UARTΪһ˿ڣǩ˿ڹ
+ * 2026-10-19     Sxxx      V1.13ıֵprintf_USART_DEBUGFast_Numberʵ֣ȥatof/atoi/vsnprintf
+ * 2026-10-19     Sxxx      V1.14ִ֧֡ŵִ֡кACK/NACKӦ֡
+ * 2026-10-19     Sxxx      V1.15DMAշͨzf_driver_dma롢òַжϣͨռʱ˻жϽա
+ * 2026-10-19     Sxxx      V1.16ı֡֡ͬʱգ֡ͷ֣UART_DEBUG_got_is_frame ָʾǰʽ
+ * 2026-10-19     Sxxx      V1.17ıֵȫϷд룬Ӧʵдһ
+ * 2026-10-19     Sxxx      V1.18 UART_DEBUG_Tx_Free ѯͻλʣռ䣬صЭ˿ڹ
+ * 2026-10-19     Sxxx      V1.19ıǩֵͼֵǩСֵָΪд
  ********************************************************************************************************************/
 #ifndef UART_DATA_UNPACKER_H
 #define UART_DATA_UNPACKER_H
@@ -69,12 +94,37 @@ int main(void)
 #include "string.h"
 #include <stdbool.h>
 #include "zf_driver_uart.h"
+#include "zf_driver_dma.h"
 #include "Ring_Buffer.h"
+#include "Binary_Frame.h"
+#include "Protocol_Engine.h"
+#include "Fast_Number.h"
 
 
-#define PACKET_MAX_SIZE 10 // غɴС,Զ޸
-#define TAG_LENGTH 1       // ǩȣԶ޸
-#define RINGBUFFER_SIZE 64 // λС2
+#define PACKET_MAX_SIZE 64 // غɴС,Զ޸ģһЯ ǩ=ֵ
+#define TAG_LENGTH 1       // ǩ(޷ָʱ˳ȽȡǩҲǶֽڱǩС)Զ޸
+#define TAG_MAX_LENGTH 8   // ֽڱǩ󳤶ȣݰд ǩ=ֵ ~}kp=1.5}~
+#define TAG_DELIMITER '='  // ֽڱǩֵ֮ķָ
+#define TAG_BATCH_SEPARATOR ';' // һж ǩ=ֵ ֮ķָ
+#define TAG_BATCH_MAX_ITEMS (PACKET_MAX_SIZE / 2) // һĿ(Ŀ1ֽڼӷָ2ֽ)
+#define UART_DEBUG_PACKET_QUEUE_SIZE 8 // ıݰдС2ݣɻ С-1 δݰ(֡PROTOCOL_PORT_QUEUE_SIZE)
+#define PACKET_TAG_HASH_SIZE 128 // ıǩɢбС2ݣ鲻Сڱǩ2
+#define RINGBUFFER_SIZE 256 // λС2ݣDMAʱӦδֽ֮ܵ
+
+#define UART_DEBUG_USE_TEXT_FRAME (1)                 // 1 ~}}~ı֡(ԭλʽ)
+#define UART_DEBUG_USE_BINARY_FRAME (1)               // 1 ճǰ׺+CRC32Ķ֡(Binary_Frame.h)߶Ϊ1ʱ֡ͷ֣ͬʱ
+#if !UART_DEBUG_USE_TEXT_FRAME && !UART_DEBUG_USE_BINARY_FRAME
+#error "UART_DEBUG_USE_TEXT_FRAME  UART_DEBUG_USE_BINARY_FRAME 1һ"
+#endif
+#define UART_DEBUG_RX_USE_DMA (1)                     // շʽ1 DMAѭģʽд뻷λ+жϷͷ0 ÿֽڽж
+#define UART_DEBUG_USART (UART8)                      // DMAʹõĴ裬DEBUG_UART_INDEXӦ
+#define UART_DEBUG_RX_DMA_CHANNEL (DMA2_CH11)         // ôڽնӦDMAͨ(UART8_RX̶ΪDMA2ͨ11)zf_driver_dmaͨ
+#define UART_DEBUG_RX_DMA_IRQN (DMA2_Channel11_IRQn)  // DMAͨжϺ
+
+#define UART_DEBUG_TX_USE_DMA (1)                     // ͷʽ1 printfд뷢ͻλDMĄͣ0 ֽڵȴ
+#define UART_DEBUG_TX_RINGBUFFER_SIZE 512             // ͻλС2ݣŲµֽڶ
+#define UART_DEBUG_TX_DMA_CHANNEL (DMA2_CH10)         // ôڷͶӦDMAͨ(UART8_TX̶ΪDMA2ͨ10)zf_driver_dmaͨ
+#define UART_DEBUG_TX_DMA_IRQN (DMA2_Channel10_IRQn)  // DMAͨжϺ
 
 // λ޸ģ˽
 extern ring_buffer_t ringbuffer_UART_DEBUG;
@@ -82,6 +132,9 @@ extern uint8_t ringbuffer_place_UART_DEBUG[RINGBUFFER_SIZE];
 
 extern uint8_t UART_DEBUG_got_data[PACKET_MAX_SIZE]; // 3յݣ
 extern volatile bool UART_DEBUG_data_packet_ready;   // 3ݰı־λݰ1
+extern BinFrame_TpDef_struct UART_DEBUG_got_frame;   // յĶ֡
+extern bool UART_DEBUG_got_is_frame;                 // ǰʽ1 ֡(UART_DEBUG_got_frame)0 ı(UART_DEBUG_got_data)
+extern Protocol_Port_TpDef_struct UART_DEBUG_port;   // DEBUG_UARTЭ˿ڣ
 
 // ˽ԪSTARTṹкصã˽У
 // һָͣӵý
@@ -96,7 +149,7 @@ void UnpackData_Handle_Int16_IEEE754(const uint8 *packet, void *int16_value);
 // ˽нṹ壬װǩ͹ҽӺԼ洢ֵ
 typedef struct
 {
-    const char tag[TAG_LENGTH + 1];
+    const char tag[TAG_MAX_LENGTH + 1];
     Function_Unpack_Handler function_handler;
     void *value_ptr;
 } PacketTag_TpDef_struct;
@@ -104,8 +157,23 @@ typedef struct
 
 void UART_DEBUG_Init(void);
 void PacketTag_Analysis(PacketTag_TpDef_struct Tag_packet[], uint8_t tag_count);
+bool PacketFrame_Analysis(const BinFrame_TpDef_struct *frame, const PacketFrame_TpDef_struct Frame_packet[], uint8_t tag_count);
+bool PacketTag_Register(const PacketTag_TpDef_struct Tag_packet[], uint16_t tag_count);
+bool PacketTag_Dispatch(const char *packet);
+bool PacketFrame_Register(const PacketFrame_TpDef_struct Frame_packet[], uint16_t tag_count);
+bool PacketFrame_Dispatch(const BinFrame_TpDef_struct *frame);
+bool PacketFrame_Dispatch_Batch(const BinFrame_TpDef_struct *frame);
+uint8_t PacketTag_Dispatch_Batch(char *packet);
+void UART_DEBUG_Write_Buffer(const uint8_t *data, uint16_t len);
+void UART_DEBUG_Send_Frame(uint8_t tag, uint8_t type, const void *payload, uint8_t len);
 void printf_USART_DEBUG(char *format_str, ...);
 void UART_DEBUG_Ringbuffer_Processer(void);
+bool UART_DEBUG_Packet_Pending(void);
+void USART_DEBUG_DMA_IRQ_Function(void);
+void USART_DEBUG_TX_DMA_IRQ_Function(void);
+ring_buffer_size_t UART_DEBUG_Tx_Dropped_Count(void);
+uint16_t UART_DEBUG_Tx_Free(void);
+void UART_DEBUG_Tx_Flush(void);
 void DebugPrint(void);
 
 #endif // UART_DATA_UNPACKER_H
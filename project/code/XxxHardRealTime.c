@@ -0,0 +1,194 @@
+/**
+ * @brief    硬实时任务执行器
+ * @file     XxxHardRealTime.c
+ * @author   Sxxx
+ * @date     2026/10/19
+ * @version  V1_0_0
+ * @par      实现功能：
+ * - 在高频定时器中断(工程中为TIM7)内按固定频率调用少量硬实时回调，与时间片错位轮询的软实时任务分离；
+ * @par      注意事项：
+ * - 回调在中断中执行，必须短小、不可阻塞；
+ * @par      修改日志：
+ * <table>
+ * <tr><th>日期          <th>版本        <th>作者    <th>更新内容        </tr>
+ * <tr><td>2026/10/19    <td>V1_0_0      <td>Sxxx    <td>初版发布；      </tr>
+ * </table>
+ */
+#include "XxxHardRealTime.h"
+
+#ifndef NULL
+#define NULL (void *)0
+#endif
+
+static STR_XxxHardRealTime *pHardRealTimeList = NULL;  /**< 硬实时任务链表入口(按注册顺序排列的单向线性链表) */
+static unsigned short (*pGetTimestamp)(void) = NULL;    /**< 时间戳函数(为空则不测量耗时) */
+static unsigned short frameBudget = 0;                  /**< 整帧耗时预算(0:不检查) */
+static volatile unsigned short frameMaxCost = 0;        /**< 整帧最大耗时 */
+static volatile unsigned long frameOverrunCount = 0;    /**< 整帧超时次数 */
+
+/**
+ * @brief        注册
+ * @param[in]    pTask           硬实时任务对象指针
+ * @param[in]    taskFunc        任务函数的函数指针
+ * @param[in]    divider         分频值，每divider个中断节拍执行一次(0按1处理)
+ * @param[in]    budget          单次耗时预算(时间戳单位，0:不检查)
+ * @return       配置是否成功
+ * - 0   注册成功
+ * - 1   配置完成，但对象已存在，无需加入链表
+ * - -1  pTask为空指针，无效对象
+ * @par          注意事项：
+ * - 加入链表尾部，回调按注册顺序执行；加入时只有一次指针写入，定时器运行中也可注册
+ * @par          示例:
+ * @code
+ *
+ * XxxHardRealTime_Register(&m_currentLoop, Current_Loop, 1, 15);   //每个节拍执行，预算15个时间戳单位
+ * XxxHardRealTime_Register(&m_speedLoop, Speed_Loop, 10, 20);      //每10个节拍执行一次，预算20个时间戳单位
+ *
+ * @endcode
+ */
+int XxxHardRealTime_Register(STR_XxxHardRealTime *pTask,
+                             void (*taskFunc)(void),
+                             unsigned short divider,
+                             unsigned short budget)
+{
+    if (NULL == pTask)
+        return -1; /* 返回错误：无效对象 */
+
+    pTask->divider = divider ? divider : 1;
+    pTask->count = pTask->divider;
+    pTask->budget = budget;
+    pTask->lastCost = 0;
+    pTask->maxCost = 0;
+    pTask->runCount = 0;
+    pTask->overrunCount = 0;
+    pTask->taskFunc = taskFunc;
+
+    /*遍历链表，防止添加重复，同时找到链表尾部*/
+    STR_XxxHardRealTime **ppTail = &pHardRealTimeList;
+    for (; *ppTail != NULL; ppTail = &(*ppTail)->pNext)
+    {
+        if (*ppTail == pTask)
+        {
+            return 1; /* 返回成功：配置完成，但对象已存在，无需加入链表 */
+        }
+    }
+    /*加入链表*/
+    pTask->pNext = NULL;
+    *ppTail = pTask; /* 把对象加入到链表尾部 */
+
+    return 0; /* 返回成功：注册成功 */
+}
+
+/**
+ * @brief        设置时间戳函数(用于测量耗时)
+ * @param[in]    getTimestamp    返回自由计数的16位时间戳(如1us计数的定时器)，传入NULL停止测量
+ * @return       null
+ */
+void XxxHardRealTime_SetTimestamp(unsigned short (*getTimestamp)(void))
+{
+    pGetTimestamp = getTimestamp;
+}
+
+/**
+ * @brief        设置整帧耗时预算
+ * @param[in]    budget          一次中断内全部回调的耗时预算(时间戳单位，0:不检查)，应小于中断周期
+ * @return       null
+ */
+void XxxHardRealTime_SetFrameBudget(unsigned short budget)
+{
+    frameBudget = budget;
+}
+
+/**
+ * @brief        获取整帧超时次数
+ * @param        null
+ * @return       整帧超时次数
+ */
+unsigned long XxxHardRealTime_GetFrameOverrunCount(void)
+{
+    return frameOverrunCount;
+}
+
+/**
+ * @brief        获取整帧最大耗时
+ * @param        null
+ * @return       整帧最大耗时(时间戳单位)
+ */
+unsigned short XxxHardRealTime_GetFrameMaxCost(void)
+{
+    return frameMaxCost;
+}
+
+/**
+ * @brief        清除统计数据(各任务最大耗时、执行次数、超时次数及整帧统计)
+ * @param        null
+ * @return       null
+ * @par          注意事项：
+ * - 在中断外调用时，清除过程中可能被中断更新，统计值会有一次误差
+ */
+void XxxHardRealTime_ClearStatistics(void)
+{
+    for (STR_XxxHardRealTime *pTemp = pHardRealTimeList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        pTemp->maxCost = 0;
+        pTemp->runCount = 0;
+        pTemp->overrunCount = 0;
+    }
+    frameMaxCost = 0;
+    frameOverrunCount = 0;
+}
+
+/**
+ * @brief        硬实时任务执行(放到定时器中断处理函数内)
+ * @param        null
+ * @return       null
+ * @par          注意事项：
+ * - 超出预算只做统计不打断回调，由上层根据超时次数决定降频或报警
+ */
+void XxxHardRealTime_Produce(void)
+{
+    unsigned short frameStart = (NULL != pGetTimestamp) ? pGetTimestamp() : 0;
+
+    /*遍历硬实时任务链表*/
+    for (STR_XxxHardRealTime *pTemp = pHardRealTimeList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        if (--pTemp->count) /* 分频未到 */
+        {
+            continue;
+        }
+        pTemp->count = pTemp->divider; /* 计数器重载 */
+        ++pTemp->runCount;
+
+        if (NULL == pGetTimestamp) /* 不测量耗时 */
+        {
+            pTemp->taskFunc();
+            continue;
+        }
+
+        unsigned short startStamp = pGetTimestamp();
+        pTemp->taskFunc();
+        unsigned short cost = (unsigned short)(pGetTimestamp() - startStamp);
+        pTemp->lastCost = cost;
+        if (cost > pTemp->maxCost)
+        {
+            pTemp->maxCost = cost;
+        }
+        if (pTemp->budget && (cost > pTemp->budget))
+        {
+            ++pTemp->overrunCount; /* 超出预算 */
+        }
+    }
+
+    if (NULL != pGetTimestamp)
+    {
+        unsigned short frameCost = (unsigned short)(pGetTimestamp() - frameStart);
+        if (frameCost > frameMaxCost)
+        {
+            frameMaxCost = frameCost;
+        }
+        if (frameBudget && (frameCost > frameBudget))
+        {
+            ++frameOverrunCount; /* 整帧超时 */
+        }
+    }
+}
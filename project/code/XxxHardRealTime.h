@@ -0,0 +1,77 @@
+/**
+ * @brief    硬实时任务执行器
+ * @file     XxxHardRealTime.h
+ * @author   Sxxx
+ * @date     2026/10/19
+ * @version  V1_0_0
+ * @par      实现功能：
+ * - 在高频定时器中断(工程中为TIM7)内按固定频率调用少量硬实时回调(如10~20kHz电流环)，与时间片错位轮询的软实时任务分离；
+ * - 每个回调可按中断节拍分频，记录单次耗时、最大耗时，超出预算时累计超时次数；
+ * - 可设置整帧(一次中断内全部回调)的耗时预算，超出时累计帧超时次数；
+ * @par      注意事项：
+ * - 回调在中断中执行，必须短小、不可阻塞、不可调用printf等耗时函数；
+ * - 回调按注册顺序执行，越靠前的回调抖动越小；
+ * - 不设置时间戳函数时不测量耗时，也不做超时统计；
+ * @par      示例:
+ * @code
+ *
+ * STR_XxxHardRealTime m_currentLoop;
+ * XxxHardRealTime_SetTimestamp(Time_Slice_Timestamp);                   // 1us计数的时间戳
+ * XxxHardRealTime_SetFrameBudget(40);                                    // 50us节拍，整帧不超过40us
+ * XxxHardRealTime_Register(&m_currentLoop, Current_Loop, 1, 15);         // 每个节拍执行，预算15us
+ * pit_us_init(TIM7_PIT, 50);                                             // 20kHz节拍
+ *
+ * void TIM7_IRQHandler(void) { ... XxxHardRealTime_Produce(); ... }     // 放到定时器中断处理函数内
+ *
+ * @endcode
+ * @par      修改日志：
+ * <table>
+ * <tr><th>日期          <th>版本        <th>作者    <th>更新内容        </tr>
+ * <tr><td>2026/10/19    <td>V1_0_0      <td>Sxxx    <td>初版发布；      </tr>
+ * </table>
+ */
+#ifndef _XXXHARDREALTIME_H_
+#define _XXXHARDREALTIME_H_
+
+/**硬实时任务类*/
+typedef struct _STR_XxxHardRealTime
+{
+    unsigned short divider;                 /**< 分频值，每divider个中断节拍执行一次(1:每个节拍都执行) */
+    volatile unsigned short count;          /**< 分频计数器 */
+    unsigned short budget;                  /**< 单次耗时预算(时间戳单位，0:不检查) */
+    volatile unsigned short lastCost;       /**< 最近一次耗时 */
+    volatile unsigned short maxCost;        /**< 最大耗时 */
+    volatile unsigned long runCount;        /**< 执行次数 */
+    volatile unsigned long overrunCount;    /**< 超出预算次数 */
+    void (*taskFunc)(void);                 /**< 任务函数的函数指针 */
+    struct _STR_XxxHardRealTime *pNext;     /**< 指向下一个对象 */
+} STR_XxxHardRealTime;
+
+/********************************************函数声明********************************************/
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*注册*/
+    int XxxHardRealTime_Register(STR_XxxHardRealTime *pTask,
+                                 void (*taskFunc)(void),
+                                 unsigned short divider,
+                                 unsigned short budget);
+    /*设置时间戳函数(用于测量耗时，16位回绕计数即可)*/
+    void XxxHardRealTime_SetTimestamp(unsigned short (*getTimestamp)(void));
+    /*设置整帧耗时预算*/
+    void XxxHardRealTime_SetFrameBudget(unsigned short frameBudget);
+    /*获取整帧超时次数*/
+    unsigned long XxxHardRealTime_GetFrameOverrunCount(void);
+    /*获取整帧最大耗时*/
+    unsigned short XxxHardRealTime_GetFrameMaxCost(void);
+    /*清除统计数据*/
+    void XxxHardRealTime_ClearStatistics(void);
+    /*硬实时任务执行(放到定时器中断处理函数内)*/
+    void XxxHardRealTime_Produce(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
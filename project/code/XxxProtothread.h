@@ -0,0 +1,193 @@
+/**
+ * @brief    无栈协程(protothread)
+ * @file     XxxProtothread.h
+ * @author   Sxxx
+ * @date     2026/10/19
+ * @version  V1_0_0
+ * @par      实现功能：
+ * - 基于switch-case的局部续点实现无栈协程，挂在时间片(STR_XxxTimeSliceOffset)任务上运行；
+ * - 提供等待条件、等待事件、延时以及带超时的等待原语，多阶段流程(标定、联网等)可以让出CPU而不阻塞其他任务；
+ * - 每个协程只占用一个STR_XxxPt对象(8字节)的RAM，无需独立任务栈；
+ * @par      注意事项：
+ * - 协程函数内的局部变量在让出后不会保留，需要跨越等待点的变量请使用static或放入外部结构体；
+ * - 协程函数内不要再使用switch语句包住等待原语(会与局部续点的case冲突)；
+ * - 同一行内只能写一个等待原语(续点使用__LINE__区分)；
+ * - 延时与超时的时间单位为XxxTimeSliceOffset_Produce()的tick(工程中为1ms)；
+ * @par      示例:
+ * @code
+ *
+ * static STR_XxxPt s_calibPt;
+ * static XxxPtEvent s_calibDoneEvent;
+ *
+ * static char Calib_Thread(STR_XxxPt *pt)
+ * {
+ *     XXXPT_BEGIN(pt);
+ *     motor_step_instance_start(&m1, 100, MOTOR_DIR_FORWARD, 100, 30);
+ *     XXXPT_DELAY(pt, 500);                                           // 让出500ms，期间其他任务照常运行
+ *     XXXPT_WAIT_EVENT_TIMEOUT(pt, s_calibDoneEvent, 2000);           // 等待事件，最多2000ms
+ *     if (XXXPT_IS_TIMEOUT(pt))
+ *     {
+ *         XXXPT_EXIT(pt);                                             // 超时退出，下次调用重新开始
+ *     }
+ *     XXXPT_END(pt);
+ * }
+ *
+ * void Calib_Task(void) { Calib_Thread(&s_calibPt); }                // 包装成时间片任务函数
+ *
+ * XXXPT_INIT(&s_calibPt);
+ * XxxTimeSliceOffset_Register(&Calib_task, Calib_Task, 1, 0);        // 按1ms调度，也可注册为非定时任务
+ * XXXPT_EVENT_SET(s_calibDoneEvent);                                  // 在其他任务或中断中发出事件
+ *
+ * @endcode
+ * @par      修改日志：
+ * <table>
+ * <tr><th>日期          <th>版本        <th>作者    <th>更新内容        </tr>
+ * <tr><td>2026/10/19    <td>V1_0_0      <td>Sxxx    <td>初版发布；      </tr>
+ * </table>
+ */
+#ifndef _XXXPROTOTHREAD_H_
+#define _XXXPROTOTHREAD_H_
+
+#include "XxxTimeSliceOffset.h"
+
+/**协程对象*/
+typedef struct _STR_XxxPt
+{
+    unsigned short lc;       /**< 局部续点(0:从头开始) */
+    unsigned char timeout;   /**< 最近一次带超时等待的结果(1:超时/0:条件满足) */
+    unsigned long waitTick;  /**< 进入等待时记录的tick */
+} STR_XxxPt;
+
+/**协程事件(中断或其他任务置位，协程等待后自动清除)*/
+typedef volatile unsigned char XxxPtEvent;
+
+/**协程函数返回值*/
+#define XXXPT_WAITING 0 /**< 阻塞在等待原语上 */
+#define XXXPT_YIELDED 1 /**< 主动让出 */
+#define XXXPT_EXITED 2  /**< 提前退出 */
+#define XXXPT_ENDED 3   /**< 运行结束 */
+
+/********************************************协程控制********************************************/
+/*初始化协程对象，下次调用从头开始*/
+#define XXXPT_INIT(pt) \
+    do                 \
+    {                  \
+        (pt)->lc = 0;  \
+    } while (0)
+
+/*协程函数体开始*/
+#define XXXPT_BEGIN(pt)          \
+    {                            \
+        char ptYieldFlag = 1;    \
+        (void)ptYieldFlag;       \
+        switch ((pt)->lc)        \
+        {                        \
+        case 0:
+
+/*协程函数体结束，运行结束后自动复位，下次调用重新开始*/
+#define XXXPT_END(pt)      \
+        }                  \
+        ptYieldFlag = 0;   \
+        XXXPT_INIT(pt);    \
+        return XXXPT_ENDED; \
+    }
+
+/*提前退出协程，下次调用重新开始*/
+#define XXXPT_EXIT(pt)          \
+    do                          \
+    {                           \
+        XXXPT_INIT(pt);         \
+        return XXXPT_EXITED;    \
+    } while (0)
+
+/*重新从头开始运行协程*/
+#define XXXPT_RESTART(pt)       \
+    do                          \
+    {                           \
+        XXXPT_INIT(pt);         \
+        return XXXPT_WAITING;   \
+    } while (0)
+
+/*协程是否正在运行(未处于起点)*/
+#define XXXPT_IS_RUNNING(pt) (0 != (pt)->lc)
+
+/********************************************等待原语********************************************/
+/*等待条件成立，条件不成立时让出*/
+#define XXXPT_WAIT_UNTIL(pt, condition)    \
+    do                                     \
+    {                                      \
+        (pt)->lc = __LINE__;               \
+    case __LINE__:                         \
+        if (!(condition))                  \
+        {                                  \
+            return XXXPT_WAITING;          \
+        }                                  \
+    } while (0)
+
+/*条件成立期间一直等待*/
+#define XXXPT_WAIT_WHILE(pt, condition) XXXPT_WAIT_UNTIL((pt), !(condition))
+
+/*无条件让出一次，下次调度从此处继续*/
+#define XXXPT_YIELD(pt)               \
+    do                                \
+    {                                 \
+        ptYieldFlag = 0;              \
+        (pt)->lc = __LINE__;          \
+    case __LINE__:                    \
+        if (0 == ptYieldFlag)         \
+        {                             \
+            return XXXPT_YIELDED;     \
+        }                             \
+    } while (0)
+
+/*等待子协程运行结束*/
+#define XXXPT_WAIT_THREAD(pt, thread) XXXPT_WAIT_WHILE((pt), (thread) < XXXPT_EXITED)
+
+/*延时ticks个tick，期间让出*/
+#define XXXPT_DELAY(pt, ticks)                                                                     \
+    do                                                                                             \
+    {                                                                                              \
+        (pt)->waitTick = XxxTimeSliceOffset_GetTick();                                             \
+        XXXPT_WAIT_UNTIL((pt), (XxxTimeSliceOffset_GetTick() - (pt)->waitTick) >= (unsigned long)(ticks)); \
+    } while (0)
+
+/*带超时等待条件成立，结束后用XXXPT_IS_TIMEOUT()判断结果*/
+#define XXXPT_WAIT_UNTIL_TIMEOUT(pt, condition, ticks)                                                    \
+    do                                                                                                    \
+    {                                                                                                     \
+        (pt)->waitTick = XxxTimeSliceOffset_GetTick();                                                    \
+        (pt)->timeout = 0;                                                                                \
+        XXXPT_WAIT_UNTIL((pt), (condition) ||                                                             \
+                                   ((pt)->timeout = ((XxxTimeSliceOffset_GetTick() - (pt)->waitTick) >= (unsigned long)(ticks)))); \
+    } while (0)
+
+/*最近一次带超时等待是否超时*/
+#define XXXPT_IS_TIMEOUT(pt) (0 != (pt)->timeout)
+
+/********************************************事件********************************************/
+/*发出事件(可在中断中调用)*/
+#define XXXPT_EVENT_SET(event) ((event) = 1)
+
+/*清除事件*/
+#define XXXPT_EVENT_CLEAR(event) ((event) = 0)
+
+/*等待事件，事件到达后自动清除*/
+#define XXXPT_WAIT_EVENT(pt, event)            \
+    do                                         \
+    {                                          \
+        XXXPT_WAIT_UNTIL((pt), 0 != (event));  \
+        XXXPT_EVENT_CLEAR(event);              \
+    } while (0)
+
+/*带超时等待事件，事件到达后自动清除，结束后用XXXPT_IS_TIMEOUT()判断结果*/
+#define XXXPT_WAIT_EVENT_TIMEOUT(pt, event, ticks)               \
+    do                                                           \
+    {                                                            \
+        XXXPT_WAIT_UNTIL_TIMEOUT((pt), 0 != (event), (ticks));   \
+        if (!XXXPT_IS_TIMEOUT(pt))                               \
+        {                                                        \
+            XXXPT_EVENT_CLEAR(event);                            \
+        }                                                        \
+    } while (0)
+
+#endif
@@ -4,7 +4,7 @@
  * @author   何锡斌
  * @email    2537274979@qq.com
  * @date     2024/01/26
- * @version  V1_0_0
+ * @version  V1_4_3
  * @par      实现功能：
  * - 基于外部提供的tick(systick中断或定时器中断)，根据注册生成多种时间片(支持0*tick)轮询调用任务，优化裸机程序架构；
  * @par      注意事项：
@@ -13,6 +13,13 @@
  * <table>
  * <tr><th>日期          <th>版本        <th>作者    <th>更新内容        </tr>
  * <tr><td>2024/01/26    <td>V1_0_0      <td>何锡斌  <td>初版发布；      </tr>
+ * <tr><td>2026/10/19    <td>V1_1_0      <td>Sxxx    <td>新增tick计数，供XxxProtothread延时/超时使用；      </tr>
+ * <tr><td>2026/10/19    <td>V1_2_0      <td>Sxxx    <td>新增自动错位：按周期与实测耗时分配偏移量，降低单tick峰值负载；      </tr>
+ * <tr><td>2026/10/19    <td>V1_3_0      <td>Sxxx    <td>新增注销、挂起/恢复、修改周期接口，可与时间片生成中断并发调用；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_0      <td>Sxxx    <td>新增空闲钩子与tick补偿，支持无节拍(tickless)低功耗空闲；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_1      <td>Sxxx    <td>新增空闲tick查询，空闲钩子可屏蔽中断后复查再睡眠，避免漏唤醒；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_2      <td>Sxxx    <td>周期大于负载窗口的任务只在窗口内错位且重新分配时保持不动，重新分配优先保持原相位；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_3      <td>Sxxx    <td>新增临界区钩子，注册/注销的链表修改在临界区内完成，可在中断中调用；      </tr>
  * </table>
  */
 #include "XxxTimeSliceOffset.h"
@@ -22,25 +29,136 @@
 #endif
 
 static STR_XxxTimeSliceOffset *pTimeSliceList = NULL; /**< 时间片链表入口(仅入口，最终直接指向设备实体，所需无需申请空间。链表是单向线性链表) */
+static volatile unsigned long tickCount = 0;           /**< tick计数(每次XxxTimeSliceOffset_Produce加一，溢出后回绕，比较时使用差值) */
+static unsigned short (*pGetTimestamp)(void) = NULL;   /**< 时间戳函数(用于测量任务耗时，为空则不测量) */
+static void (*pIdleFunc)(unsigned short) = NULL;        /**< 空闲钩子(为空则忙等) */
+static unsigned int (*pEnterCritical)(void) = NULL;     /**< 进入临界区(屏蔽中断并返回原状态，为空则不屏蔽) */
+static void (*pExitCritical)(unsigned int) = NULL;      /**< 退出临界区(恢复进入前的中断状态) */
+
+/**
+ * @brief        进入临界区
+ * @return       进入前的中断状态
+ */
+static unsigned int XxxTimeSliceOffset_EnterCritical(void)
+{
+    return (NULL != pEnterCritical) ? pEnterCritical() : 0;
+}
+
+/**
+ * @brief        退出临界区
+ * @param[in]    state           XxxTimeSliceOffset_EnterCritical的返回值
+ */
+static void XxxTimeSliceOffset_ExitCritical(unsigned int state)
+{
+    if (NULL != pExitCritical)
+    {
+        pExitCritical(state);
+    }
+}
+
+/**
+ * @brief        把一个定时任务的负载累加到负载窗口
+ * @param[out]   pLoad           负载窗口，pLoad[k]表示k+1个tick之后的负载
+ * @param[in]    firstDelay      距下一次运行的tick数(1~reloadVal)
+ * @param[in]    reloadVal       任务周期
+ * @param[in]    weight          任务每次运行的负载
+ */
+static void XxxTimeSliceOffset_AddLoad(unsigned short *pLoad,
+                                       unsigned short firstDelay,
+                                       unsigned short reloadVal,
+                                       unsigned short weight)
+{
+    for (unsigned short slot = firstDelay - 1; slot < XXXTIMESLICEOFFSET_BALANCE_WINDOW; slot += reloadVal)
+    {
+        pLoad[slot] = (0xFFFF - pLoad[slot] < weight) ? 0xFFFF : (pLoad[slot] + weight); /* 饱和累加 */
+    }
+}
+
+/**
+ * @brief        统计当前已注册定时任务的负载窗口
+ * @param[out]   pLoad           负载窗口
+ * @param[in]    pExclude        不计入统计的对象(可为空)
+ * @param[in]    excludeAuto     1:不统计会被重新分配的自动错位任务(周期不大于窗口)/0:统计全部
+ */
+static void XxxTimeSliceOffset_BuildLoad(unsigned short *pLoad,
+                                         const STR_XxxTimeSliceOffset *pExclude,
+                                         unsigned char excludeAuto)
+{
+    for (unsigned short slot = 0; slot < XXXTIMESLICEOFFSET_BALANCE_WINDOW; ++slot)
+    {
+        pLoad[slot] = 0;
+    }
+    for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        if ((pTemp == pExclude) || (0 == pTemp->reloadVal) || pTemp->suspend || (excludeAuto && pTemp->autoOffset && (pTemp->reloadVal <= XXXTIMESLICEOFFSET_BALANCE_WINDOW)))
+        {
+            continue; /* 非定时任务每次轮询都执行，不参与错位；挂起的任务不占负载 */
+        }
+        XxxTimeSliceOffset_AddLoad(pLoad, pTemp->count, pTemp->reloadVal, pTemp->cost ? pTemp->cost : 1);
+    }
+}
+
+/**
+ * @brief        为自动错位任务选择距下一次运行的tick数，使其运行时刻的峰值负载最小
+ * @param[in]    pTSlice         时间片对象指针(定时任务)
+ * @param[in]    pLoad           负载窗口，选定后把本任务负载累加进去
+ * @param[in]    keepDelay       优先保持的当前位置(距下一次运行的tick数)，0表示没有
+ * @par          注意事项：
+ * - 峰值相同时选择总负载较小的位置，仍相同时保持当前位置，否则选择最早的位置
+ * - 周期大于负载窗口时只在窗口内选择第一次运行的位置，窗口之外的负载看不到
+ */
+static void XxxTimeSliceOffset_Place(STR_XxxTimeSliceOffset *pTSlice, unsigned short *pLoad, unsigned short keepDelay)
+{
+    unsigned short weight = pTSlice->cost ? pTSlice->cost : 1;
+    unsigned short maxDelay = (pTSlice->reloadVal < XXXTIMESLICEOFFSET_BALANCE_WINDOW) ? pTSlice->reloadVal : XXXTIMESLICEOFFSET_BALANCE_WINDOW;
+    unsigned short bestDelay = maxDelay;
+    unsigned long bestPeak = 0xFFFFFFFF;
+    unsigned long bestSum = 0xFFFFFFFF;
+
+    for (unsigned short delay = 1; delay <= maxDelay; ++delay)
+    {
+        unsigned long peak = 0;
+        unsigned long sum = 0;
+        for (unsigned short slot = delay - 1; slot < XXXTIMESLICEOFFSET_BALANCE_WINDOW; slot += pTSlice->reloadVal)
+        {
+            unsigned long load = (unsigned long)pLoad[slot] + weight;
+            peak = (load > peak) ? load : peak;
+            sum += load;
+        }
+        if ((peak < bestPeak) || ((peak == bestPeak) && (sum < bestSum)) ||
+            ((peak == bestPeak) && (sum == bestSum) && (delay == keepDelay)))
+        {
+            bestPeak = peak;
+            bestSum = sum;
+            bestDelay = delay;
+        }
+    }
+
+    pTSlice->count = bestDelay; /* 16位写入，与中断中的递减不会撕裂 */
+    XxxTimeSliceOffset_AddLoad(pLoad, bestDelay, pTSlice->reloadVal, weight);
+}
 
 /**
  * @brief        注册
  * @param[in]    pTSlice         时间片对象指针
  * @param[in]    taskFunc        任务函数的函数指针
  * @param[in]    reloadVal       时间片重载值*tick基准即为任务执行间隔
- * @param[in]    offset          偏移量，这是错位的精髓
+ * @param[in]    offset          偏移量，这是错位的精髓；传入XXXTIMESLICEOFFSET_OFFSET_AUTO由调度器自动分配
  * @return       配置是否成功
  * - 0   注册成功
  * - 1   配置完成，但对象已存在，无需加入链表
  * - -1  pTSlice为空指针，无效对象
  * @par          注意事项：
  * - reloadVal设置为零即非定时任务，则offset偏移量无效
+ * - 加入链表在临界区内完成(见XxxTimeSliceOffset_SetCriticalHook)，不会与时间片生成中断的遍历交错
+ * - 自动分配时按已注册任务的周期与耗时(未测得耗时按1计)选择峰值负载最小的错位，运行一段时间后可调用XxxTimeSliceOffset_Balance()按实测耗时重新分配
  * @par          示例:
  * @code
  *
  * XxxTimeSliceOffset_Register(&m_timeSlice_1, Task_1, 0, 0);        //0，即非定时任务(每次轮询都会执行)
  * XxxTimeSliceOffset_Register(&m_timeSlice_2, Task_2, 10, 0);       //10*1ms，即10ms运行一次
  * XxxTimeSliceOffset_Register(&m_timeSlice_3, Task_3, 10, 5);       //10*1ms，即10ms运行一次，与Task_2错开5ms，这样就不会集中到同一个10ms的时间点上
+ * XxxTimeSliceOffset_Register(&m_timeSlice_4, Task_4, 10, XXXTIMESLICEOFFSET_OFFSET_AUTO); //10ms运行一次，错位由调度器自动分配
  *
  * @endcode
  */
@@ -52,9 +170,21 @@ int XxxTimeSliceOffset_Register(STR_XxxTimeSliceOffset *pTSlice,
     if (NULL == pTSlice)
         return -1; /* 返回错误：无效对象 */
 
+    pTSlice->suspend = 0;
     pTSlice->reloadVal = reloadVal;
-    pTSlice->count = reloadVal + offset; /* 添加偏移量，使得同一数值的时间片错开 */
     pTSlice->taskFunc = taskFunc;
+    pTSlice->cost = 0;
+    pTSlice->autoOffset = (XXXTIMESLICEOFFSET_OFFSET_AUTO == offset) ? 1 : 0;
+    if (pTSlice->autoOffset && reloadVal) /* 自动错位 */
+    {
+        unsigned short load[XXXTIMESLICEOFFSET_BALANCE_WINDOW];
+        XxxTimeSliceOffset_BuildLoad(load, pTSlice, 0);
+        XxxTimeSliceOffset_Place(pTSlice, load, 0);
+    }
+    else
+    {
+        pTSlice->count = reloadVal + (pTSlice->autoOffset ? 0 : offset); /* 添加偏移量，使得同一数值的时间片错开 */
+    }
     if (0 == reloadVal) /* 非定时任务 */
     {
         pTSlice->runFlag = 1; /* 非定时任务可运行标志默认为一 */
@@ -64,42 +194,199 @@ int XxxTimeSliceOffset_Register(STR_XxxTimeSliceOffset *pTSlice,
         pTSlice->runFlag = 0; /* 定时任务可运行标志默认为零 */
     }
 
+    unsigned int state = XxxTimeSliceOffset_EnterCritical();
     /*遍历链表，防止添加重复*/
     for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
     {
         if (pTemp == pTSlice)
         {
+            XxxTimeSliceOffset_ExitCritical(state);
             return 1; /* 返回成功：配置完成，但对象已存在，无需加入链表 */
         }
     }
     /*加入链表*/
     pTSlice->pNext = pTimeSliceList;
     pTimeSliceList = pTSlice; /* 把对象加入到链表头部 */
+    XxxTimeSliceOffset_ExitCritical(state);
 
     return 0; /* 返回成功：注册成功 */
 }
 
+/**
+ * @brief        注销
+ * @param[in]    pTSlice         时间片对象指针
+ * @return       注销是否成功
+ * - 0   注销成功
+ * - 1   对象不在链表中，无需注销
+ * - -1  pTSlice为空指针，无效对象
+ * @par          注意事项：
+ * - 可在任务函数(包括被注销任务自身)中调用，注销后不再占用任何CPU时间
+ * - 在中断中调用，或注册/注销可能被中断中的注册/注销打断时，必须先用XxxTimeSliceOffset_SetCriticalHook()设置临界区钩子
+ * - 摘除在临界区内完成，被注销对象的pNext保持不变，正在遍历到该对象的轮询仍能继续走完链表
+ * - 对象注销后可重新注册
+ */
+int XxxTimeSliceOffset_Unregister(STR_XxxTimeSliceOffset *pTSlice)
+{
+    if (NULL == pTSlice)
+        return -1; /* 返回错误：无效对象 */
+
+    unsigned int state = XxxTimeSliceOffset_EnterCritical();
+    for (STR_XxxTimeSliceOffset **ppTemp = &pTimeSliceList; *ppTemp != NULL; ppTemp = &(*ppTemp)->pNext)
+    {
+        if (*ppTemp == pTSlice)
+        {
+            pTSlice->suspend = 1;     /* 冻结，恢复前中断不再修改该对象 */
+            *ppTemp = pTSlice->pNext; /* 把对象从链表中摘除 */
+            pTSlice->runFlag = 0;
+            XxxTimeSliceOffset_ExitCritical(state);
+            return 0; /* 返回成功：注销成功 */
+        }
+    }
+    XxxTimeSliceOffset_ExitCritical(state);
+    return 1; /* 返回成功：对象不在链表中 */
+}
+
+/**
+ * @brief        挂起
+ * @param[in]    pTSlice         时间片对象指针
+ * @return       挂起是否成功
+ * - 0   挂起成功
+ * - -1  pTSlice为空指针，无效对象
+ * @par          注意事项：
+ * - 挂起后计数器冻结、任务不再被调用，恢复后从冻结处继续计时，错位关系保持不变
+ */
+int XxxTimeSliceOffset_Suspend(STR_XxxTimeSliceOffset *pTSlice)
+{
+    if (NULL == pTSlice)
+        return -1; /* 返回错误：无效对象 */
+
+    pTSlice->suspend = 1;
+    return 0;
+}
+
+/**
+ * @brief        恢复
+ * @param[in]    pTSlice         时间片对象指针
+ * @return       恢复是否成功
+ * - 0   恢复成功
+ * - -1  pTSlice为空指针，无效对象
+ */
+int XxxTimeSliceOffset_Resume(STR_XxxTimeSliceOffset *pTSlice)
+{
+    if (NULL == pTSlice)
+        return -1; /* 返回错误：无效对象 */
+
+    pTSlice->suspend = 0;
+    return 0;
+}
+
+/**
+ * @brief        修改周期
+ * @param[in]    pTSlice         时间片对象指针
+ * @param[in]    reloadVal       新的时间片重载值
+ * @param[in]    offset          新的偏移量；传入XXXTIMESLICEOFFSET_OFFSET_AUTO由调度器自动分配
+ * @return       修改是否成功
+ * - 0   修改成功
+ * - -1  pTSlice为空指针，无效对象
+ * @par          注意事项：
+ * - 修改期间对象被临时冻结，中断不会读到一半的新配置；修改后从新的周期重新计时，原来的挂起状态保持不变
+ */
+int XxxTimeSliceOffset_ChangePeriod(STR_XxxTimeSliceOffset *pTSlice,
+                                    unsigned short reloadVal,
+                                    unsigned short offset)
+{
+    if (NULL == pTSlice)
+        return -1; /* 返回错误：无效对象 */
+
+    unsigned char suspend = pTSlice->suspend;
+    pTSlice->suspend = 1; /* 冻结，中断不再修改计数器 */
+
+    pTSlice->reloadVal = reloadVal;
+    pTSlice->autoOffset = (XXXTIMESLICEOFFSET_OFFSET_AUTO == offset) ? 1 : 0;
+    if (pTSlice->autoOffset && reloadVal) /* 自动错位 */
+    {
+        unsigned short load[XXXTIMESLICEOFFSET_BALANCE_WINDOW];
+        XxxTimeSliceOffset_BuildLoad(load, pTSlice, 0);
+        XxxTimeSliceOffset_Place(pTSlice, load, 0);
+    }
+    else
+    {
+        pTSlice->count = reloadVal + (pTSlice->autoOffset ? 0 : offset);
+    }
+    pTSlice->runFlag = (0 == reloadVal) ? 1 : 0; /* 非定时任务可运行标志为一，定时任务重新倒计时 */
+
+    pTSlice->suspend = suspend;
+    return 0;
+}
+
+/**
+ * @brief        获取可以空闲的tick数
+ * @param        null
+ * @return       距最近一个定时任务到期的tick数；有任务可运行时返回0；没有定时任务时返回XXXTIMESLICEOFFSET_IDLE_FOREVER
+ * @par          注意事项：
+ * - 空闲钩子屏蔽中断后再调用一次复查，返回0说明检查之后有中断恢复了任务，不要睡眠
+ */
+unsigned short XxxTimeSliceOffset_GetIdleTicks(void)
+{
+    unsigned short idleTicks = XXXTIMESLICEOFFSET_IDLE_FOREVER;
+    for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        if (pTemp->suspend)
+        {
+            continue; /* 挂起的任务不影响空闲 */
+        }
+        if ((0 == pTemp->reloadVal) || pTemp->runFlag)
+        {
+            return 0; /* 有任务可运行(非定时任务需挂起自身才允许空闲) */
+        }
+        idleTicks = (pTemp->count < idleTicks) ? pTemp->count : idleTicks;
+    }
+    return idleTicks;
+}
+
 /**
  * @brief        启动时间片错位轮询(代替main的while循环)
  * @param        null
  * @return       null
  * @par          注意事项：
- * - null
+ * - 设置了空闲钩子时，每轮轮询前检查是否所有未挂起的任务都不可运行，是则调用空闲钩子
  */
 void XxxTimeSliceOffset_Start(void)
 {
     while (1) /* 代替main的while循环 */
     {
+        if (NULL != pIdleFunc) /* 没有任务可运行时进入空闲钩子 */
+        {
+            unsigned short idleTicks = XxxTimeSliceOffset_GetIdleTicks();
+            if (idleTicks)
+            {
+                pIdleFunc(idleTicks);
+            }
+        }
+
         /*遍历时间片链表*/
         for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
         {
-            if (pTemp->runFlag) /* 可运行则调用任务函数 */
+            if (pTemp->runFlag && !pTemp->suspend) /* 可运行且未挂起则调用任务函数 */
             {
                 if (pTemp->reloadVal) /* 重载值不为0，即定时任务 */
                 {
                     pTemp->runFlag = 0; /* 可运行标志清零，开启新一轮倒计时 */
                 }
-                pTemp->taskFunc();
+                if (NULL != pGetTimestamp) /* 测量任务耗时，记录最大值 */
+                {
+                    unsigned short startStamp = pGetTimestamp();
+                    pTemp->taskFunc();
+                    unsigned short elapsed = (unsigned short)(pGetTimestamp() - startStamp);
+                    if (elapsed > pTemp->cost)
+                    {
+                        pTemp->cost = elapsed;
+                    }
+                }
+                else
+                {
+                    pTemp->taskFunc();
+                }
             }
         }
     }
@@ -114,10 +401,12 @@ void XxxTimeSliceOffset_Start(void)
  */
 void XxxTimeSliceOffset_Produce(void)
 {
+    ++tickCount; /* tick计数 */
+
     /*遍历时间片链表*/
     for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
     {
-        if (pTemp->reloadVal) /* 重载值不为0，即定时任务 */
+        if (pTemp->reloadVal && !pTemp->suspend) /* 重载值不为0且未挂起，即运行中的定时任务 */
         {
             --pTemp->count;        /* 计数器递减 */
             if (0 == pTemp->count) /* 计数器递减到零 */
@@ -128,3 +417,149 @@ void XxxTimeSliceOffset_Produce(void)
         }
     }
 }
+
+/**
+ * @brief        获取自启动以来的tick计数
+ * @param        null
+ * @return       tick计数
+ * @par          注意事项：
+ * - 32位计数溢出后回绕，判断时间间隔请使用差值：(XxxTimeSliceOffset_GetTick() - start) >= interval
+ */
+unsigned long XxxTimeSliceOffset_GetTick(void)
+{
+    return tickCount;
+}
+
+/**
+ * @brief        设置时间戳函数(用于测量任务耗时)
+ * @param[in]    getTimestamp    返回自由计数的16位时间戳(如1us计数的定时器)，传入NULL停止测量
+ * @return       null
+ * @par          注意事项：
+ * - 时间戳按16位回绕相减，单次任务耗时不能超过一个计数周期
+ * @par          示例:
+ * @code
+ *
+ * static unsigned short TimeSlice_Timestamp(void) { return timer_get(TIM_5); }
+ * timer_init(TIM_5, TIMER_US);
+ * XxxTimeSliceOffset_SetTimestamp(TimeSlice_Timestamp);
+ *
+ * @endcode
+ */
+void XxxTimeSliceOffset_SetTimestamp(unsigned short (*getTimestamp)(void))
+{
+    pGetTimestamp = getTimestamp;
+}
+
+/**
+ * @brief        按实测耗时重新分配所有自动错位任务的偏移量
+ * @param        null
+ * @return       null
+ * @par          注意事项：
+ * - 手动偏移的任务与周期大于负载窗口的自动错位任务保持不动，其余自动错位任务按耗时从大到小(耗时相同则周期短的优先)依次选择峰值负载最小的位置
+ * - 负载相同时保持原位置(相位不变)；位置改变的任务本次到期时刻随之改变，两次运行的间隔最多偏差一个周期
+ * - 在任务函数中调用即可，重新分配期间tick前进会带来至多1个tick的误差
+ */
+void XxxTimeSliceOffset_Balance(void)
+{
+    unsigned short load[XXXTIMESLICEOFFSET_BALANCE_WINDOW];
+    XxxTimeSliceOffset_BuildLoad(load, NULL, 1);
+
+    while (1)
+    {
+        /*挑选尚未分配的自动错位任务中耗时最大的一个(autoOffset为1表示待分配，2表示本轮已分配)*/
+        STR_XxxTimeSliceOffset *pPick = NULL;
+        for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
+        {
+            if ((1 != pTemp->autoOffset) || (0 == pTemp->reloadVal) || pTemp->suspend ||
+                (pTemp->reloadVal > XXXTIMESLICEOFFSET_BALANCE_WINDOW))
+            {
+                continue; /* 周期大于窗口的任务已计入负载，不移动 */
+            }
+            if ((NULL == pPick) || (pTemp->cost > pPick->cost) ||
+                ((pTemp->cost == pPick->cost) && (pTemp->reloadVal < pPick->reloadVal)))
+            {
+                pPick = pTemp;
+            }
+        }
+        if (NULL == pPick)
+        {
+            break; /* 全部分配完成 */
+        }
+        XxxTimeSliceOffset_Place(pPick, load, pPick->count);
+        pPick->autoOffset = 2;
+    }
+
+    /*恢复待分配标志，供下次重新分配*/
+    for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        if (pTemp->autoOffset)
+        {
+            pTemp->autoOffset = 1;
+        }
+    }
+}
+
+/**
+ * @brief        设置空闲钩子
+ * @param[in]    idleFunc        空闲钩子，参数为距最近一个定时任务到期的tick数(XXXTIMESLICEOFFSET_IDLE_FOREVER表示没有定时任务)，传入NULL恢复忙等
+ * @return       null
+ * @par          注意事项：
+ * - 钩子中可以只执行WFI等待下一次中断，也可以把节拍定时器改为idleTicks个tick后唤醒(无节拍空闲)，唤醒后调用XxxTimeSliceOffset_Compensate()补偿少产生的tick
+ * - 非定时任务(reloadVal为0)会一直可运行，需要在无事可做时挂起自身、由中断恢复，系统才能进入空闲
+ * - 从检查到进入睡眠之间若有中断恢复任务，会一直睡到下一次中断：钩子应屏蔽中断后调用XxxTimeSliceOffset_GetIdleTicks()复查，
+ *   为0时开中断返回，否则在屏蔽中断的状态下执行WFI(挂起的中断仍会唤醒)，醒来后再开中断
+ */
+void XxxTimeSliceOffset_SetIdleHook(void (*idleFunc)(unsigned short idleTicks))
+{
+    pIdleFunc = idleFunc;
+}
+
+/**
+ * @brief        tick补偿(一次推进多个tick，效果等同连续调用ticks次XxxTimeSliceOffset_Produce)
+ * @param[in]    ticks           需要补偿的tick数
+ * @return       null
+ * @par          注意事项：
+ * - 必须在节拍中断被屏蔽时调用(如空闲钩子中停下节拍定时器之后)，避免与XxxTimeSliceOffset_Produce同时修改计数器
+ * - 补偿期间多次到期的定时任务只会运行一次
+ */
+void XxxTimeSliceOffset_Compensate(unsigned short ticks)
+{
+    tickCount += ticks;
+
+    for (STR_XxxTimeSliceOffset *pTemp = pTimeSliceList; pTemp != NULL; pTemp = pTemp->pNext)
+    {
+        if ((0 == pTemp->reloadVal) || pTemp->suspend)
+        {
+            continue;
+        }
+        if (ticks >= pTemp->count) /* 补偿期间到期 */
+        {
+            pTemp->runFlag = 1;
+            pTemp->count = pTemp->reloadVal - ((ticks - pTemp->count) % pTemp->reloadVal); /* 到期后剩余的tick继续倒计时 */
+        }
+        else
+        {
+            pTemp->count -= ticks;
+        }
+    }
+}
+
+/**
+ * @brief        设置临界区钩子
+ * @param[in]    enterFunc       屏蔽中断并返回原中断状态，传入NULL不屏蔽(注册/注销只能在主循环中调用)
+ * @param[in]    exitFunc        按enterFunc的返回值恢复中断状态
+ * @return       null
+ * @par          注意事项：
+ * - 注册、注销修改链表时调用，时间片生成中断中的遍历不会看到修改到一半的链表；需要在中断中注册/注销时必须设置
+ * @par          示例:
+ * @code
+ *
+ * XxxTimeSliceOffset_SetCriticalHook(interrupt_global_disable, interrupt_global_enable);
+ *
+ * @endcode
+ */
+void XxxTimeSliceOffset_SetCriticalHook(unsigned int (*enterFunc)(void), void (*exitFunc)(unsigned int state))
+{
+    pEnterCritical = enterFunc;
+    pExitCritical = exitFunc;
+}
@@ -4,7 +4,7 @@
  * @author   何锡斌
  * @email    2537274979@qq.com
  * @date     2024/01/26
- * @version  V1_0_0
+ * @version  V1_4_3
  * @par      实现功能：
  * - 基于外部提供的tick(systick中断或定时器中断)，根据注册生成多种时间片(支持0*tick)轮询调用任务，优化裸机程序架构；
  * @par      注意事项：
@@ -13,17 +13,31 @@
  * <table>
  * <tr><th>日期          <th>版本        <th>作者    <th>更新内容        </tr>
  * <tr><td>2024/01/26    <td>V1_0_0      <td>何锡斌  <td>初版发布；      </tr>
+ * <tr><td>2026/10/19    <td>V1_1_0      <td>Sxxx    <td>新增tick计数，供XxxProtothread延时/超时使用；      </tr>
+ * <tr><td>2026/10/19    <td>V1_2_0      <td>Sxxx    <td>新增自动错位：按周期与实测耗时分配偏移量，降低单tick峰值负载；      </tr>
+ * <tr><td>2026/10/19    <td>V1_3_0      <td>Sxxx    <td>新增注销、挂起/恢复、修改周期接口，可与时间片生成中断并发调用；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_0      <td>Sxxx    <td>新增空闲钩子与tick补偿，支持无节拍(tickless)低功耗空闲；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_1      <td>Sxxx    <td>新增空闲tick查询，空闲钩子可屏蔽中断后复查再睡眠，避免漏唤醒；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_2      <td>Sxxx    <td>周期大于负载窗口的任务只在窗口内错位且重新分配时保持不动，重新分配优先保持原相位；      </tr>
+ * <tr><td>2026/10/19    <td>V1_4_3      <td>Sxxx    <td>新增临界区钩子，注册/注销的链表修改在临界区内完成，可在中断中调用；      </tr>
  * </table>
  */
 #ifndef _XXXTIMESLICEOFFSET_H_
 #define _XXXTIMESLICEOFFSET_H_
 
+#define XXXTIMESLICEOFFSET_OFFSET_AUTO 0xFFFF   /**< 注册时传入此偏移量即由调度器自动分配错位 */
+#define XXXTIMESLICEOFFSET_BALANCE_WINDOW 100   /**< 自动错位计算负载的窗口长度(tick)，建议不小于自动错位任务的最大周期，占用2*窗口长度字节的栈；周期更长的任务建议手动指定偏移 */
+#define XXXTIMESLICEOFFSET_IDLE_FOREVER 0xFFFF  /**< 空闲钩子参数：没有运行中的定时任务，可一直睡眠到其他中断唤醒 */
+
 /**时间片类*/
 typedef struct _STR_XxxTimeSliceOffset
 {
     volatile unsigned char runFlag;        /**< 可运行标志(1:可运行/0:不可运行) */
+    volatile unsigned char suspend;        /**< 挂起标志(1:挂起，计数器冻结且不调用任务/0:正常) */
     volatile unsigned short count;         /**< 计数器 */
     unsigned short reloadVal;              /**< 重载值 */
+    unsigned char autoOffset;              /**< 自动错位标志(0:手动偏移/非0:自动分配) */
+    unsigned short cost;                   /**< 实测最大耗时(时间戳单位，未设置时间戳函数时为0) */
     void (*taskFunc)(void);                /**< 任务函数的函数指针 */
     struct _STR_XxxTimeSliceOffset *pNext; /**< 指向下一个对象 */
 } STR_XxxTimeSliceOffset;
@@ -39,10 +53,34 @@ extern "C"
                                     void (*taskFunc)(void),
                                     unsigned short reloadVal,
                                     unsigned short offset);
+    /*注销*/
+    int XxxTimeSliceOffset_Unregister(STR_XxxTimeSliceOffset *pTSlice);
+    /*挂起*/
+    int XxxTimeSliceOffset_Suspend(STR_XxxTimeSliceOffset *pTSlice);
+    /*恢复*/
+    int XxxTimeSliceOffset_Resume(STR_XxxTimeSliceOffset *pTSlice);
+    /*修改周期*/
+    int XxxTimeSliceOffset_ChangePeriod(STR_XxxTimeSliceOffset *pTSlice,
+                                        unsigned short reloadVal,
+                                        unsigned short offset);
     /*启动时间片错位轮询(代替main的while循环)*/
     void XxxTimeSliceOffset_Start(void);
     /*时间片生成(放到systick或定时器中断处理函数内)*/
     void XxxTimeSliceOffset_Produce(void);
+    /*设置时间戳函数(用于测量任务耗时，16位回绕计数即可)*/
+    void XxxTimeSliceOffset_SetTimestamp(unsigned short (*getTimestamp)(void));
+    /*按实测耗时重新分配所有自动错位任务的偏移量*/
+    void XxxTimeSliceOffset_Balance(void);
+    /*设置空闲钩子(没有任务可运行时调用，参数为距最近一个任务到期的tick数)*/
+    void XxxTimeSliceOffset_SetIdleHook(void (*idleFunc)(unsigned short idleTicks));
+    /*获取可以空闲的tick数(空闲钩子屏蔽中断后复查用)*/
+    unsigned short XxxTimeSliceOffset_GetIdleTicks(void);
+    /*tick补偿(无节拍空闲唤醒后一次推进多个tick)*/
+    void XxxTimeSliceOffset_Compensate(unsigned short ticks);
+    /*获取自启动以来的tick计数*/
+    unsigned long XxxTimeSliceOffset_GetTick(void);
+    /*设置临界区钩子(注册/注销修改链表时屏蔽中断)*/
+    void XxxTimeSliceOffset_SetCriticalHook(unsigned int (*enterFunc)(void), void (*exitFunc)(unsigned int state));
 
 #ifdef __cplusplus
 }
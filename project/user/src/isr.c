@@ -45,6 +45,8 @@ void UART5_IRQHandler (void) __attribute__((interrupt()));
 void UART6_IRQHandler (void) __attribute__((interrupt()));
 void UART7_IRQHandler (void) __attribute__((interrupt()));
 void UART8_IRQHandler (void) __attribute__((interrupt()));
+void DMA2_Channel10_IRQHandler (void) __attribute__((interrupt()));
+void DMA2_Channel11_IRQHandler (void) __attribute__((interrupt()));
 void DVP_IRQHandler (void) __attribute__((interrupt()));
 //void TIM1_BRK_IRQHandler        (void)  __attribute__((interrupt()));
 void TIM1_UP_IRQHandler         (void)  __attribute__((interrupt()));
@@ -79,6 +81,7 @@ void EXTI15_10_IRQHandler(void) __attribute__((interrupt()));
 
 void USART1_IRQHandler(void)
 {
+    uart_tx_handler(UART_1);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(USART1, USART_IT_RXNE) != RESET)
     {
 
@@ -87,6 +90,7 @@ void USART1_IRQHandler(void)
 }
 void USART2_IRQHandler(void)
 {
+    uart_tx_handler(UART_2);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(USART2, USART_IT_RXNE) != RESET)
     {
 
@@ -96,6 +100,7 @@ void USART2_IRQHandler(void)
 }
 void USART3_IRQHandler(void)
 {
+    uart_tx_handler(UART_3);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(USART3, USART_IT_RXNE) != RESET)
     {
 #if DEBUG_UART_USE_INTERRUPT                                                    //  debug ж
@@ -107,6 +112,7 @@ void USART3_IRQHandler(void)
 }
 void UART4_IRQHandler (void)
 {
+    uart_tx_handler(UART_4);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(UART4, USART_IT_RXNE) != RESET)
     {
 
@@ -115,6 +121,7 @@ void UART4_IRQHandler (void)
 }
 void UART5_IRQHandler (void)
 {
+    uart_tx_handler(UART_5);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(UART5, USART_IT_RXNE) != RESET)
     {
         camera_uart_handler();
@@ -123,6 +130,7 @@ void UART5_IRQHandler (void)
 }
 void UART6_IRQHandler (void)
 {
+    uart_tx_handler(UART_6);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(UART6, USART_IT_RXNE) != RESET)
     {
 
@@ -131,22 +139,53 @@ void UART6_IRQHandler (void)
 }
 void UART7_IRQHandler (void)
 {
+    uart_tx_handler(UART_7);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(UART7, USART_IT_RXNE) != RESET)
     {
         wireless_module_uart_handler();
+#if PROTOCOL_USE_WIRELESS_PORT
+        XxxTimeSliceOffset_Resume(&Uart_task);                                  // ߴյݣָݰ
+#endif
         USART_ClearITPendingBit(UART7, USART_IT_RXNE);
     }
 }
 void UART8_IRQHandler (void)
 {
+    uart_tx_handler(UART_8);                                                     // 첽(uart_write_buffer_async)δʱֱӷ
     if(USART_GetITStatus(UART8, USART_IT_RXNE) != RESET)
     {
         gnss_uart_callback();
         USART_DEBUG_IRQ_Function();
+        XxxTimeSliceOffset_Resume(&Uart_task);                                  // յݣָݰ
         USART_ClearITPendingBit(UART8, USART_IT_RXNE);
     }
+#if UART_DEBUG_RX_USE_DMA
+    if(USART_GetITStatus(UART8, USART_IT_IDLE) != RESET)
+    {
+        USART_DEBUG_DMA_IRQ_Function();                                         // һݽϣDMAд
+        XxxTimeSliceOffset_Resume(&Uart_task);                                  // յݣָݰ
+        USART_ReceiveData(UART8);                                               // ȶ״̬ĴٶݼĴб־
+    }
+#endif
+
+}
+
+#if UART_DEBUG_TX_USE_DMA
+void DMA2_Channel10_IRQHandler (void)
+{
+    dma_irq_handler(DMA2_CH10);                                                 // һηɣصͷŲһ
+}
+#endif
 
+#if UART_DEBUG_RX_USE_DMA
+void DMA2_Channel11_IRQHandler (void)
+{
+    if(dma_irq_handler(DMA2_CH11))                                              // /ȫʱصзһΣֹ
+    {
+        XxxTimeSliceOffset_Resume(&Uart_task);
+    }
 }
+#endif
 
 
 